@@ -22,13 +22,6 @@
 
 #include "ClientPattern.hh"
 
-#include "fluxbox.hh"
-#include "FocusControl.hh"
-#include "Layer.hh"
-#include "Screen.hh"
-#include "WinClient.hh"
-#include "Workspace.hh"
-
 #include "FbTk/StringUtil.hh"
 #include "FbTk/App.hh"
 #include "FbTk/stringstream.hh"
@@ -135,6 +128,22 @@ Prop2String property_2_strings[] = { // sorted by 'prop'
 };
 
 
+bool isNumeric(ClientPattern::WinProperty prop) {
+    return prop == ClientPattern::WORKSPACE || prop == ClientPattern::HEAD ||
+           prop == ClientPattern::SCREEN;
+}
+
+// parses plain non-negative numbers, written the way number2String does
+bool parseNumber(const FbTk::FbString &str, int &number) {
+    const char *first = str.data(), *last = first + str.size();
+    long long n;
+    if (FbTk::StringUtil::chars2Number(first, last, n) != last ||
+        n < 0 || n > 999999999)
+        return false;
+    number = static_cast<int>(n);
+    return true;
+}
+
 } // end of anonymous namespace
 
 
@@ -146,14 +155,43 @@ Prop2String property_2_strings[] = { // sorted by 'prop'
  */
 struct ClientPattern::Term {
 
+    /// how the term is checked, decided once when it is created
+    enum Kind {
+        REGEXP,     ///< run the regular expression
+        NUMBER,     ///< compare the number (workspace, head, screen)
+        CURRENT,    ///< compare with the focused window / current workspace
+        MOUSE_HEAD  ///< compare with the head the mouse is on
+    };
+
     Term(const FbTk::FbString& _regstr, WinProperty _prop, bool _negate, const FbTk::FbString& _xprop) :
         regstr(_regstr),
         xpropstr(_xprop),
+        xprop(None),
         regexp(_regstr, true),
         prop(_prop),
-        negate(_negate) {
+        negate(_negate),
+        kind(REGEXP),
+        number(0) {
+
+        if (prop == XPROP)
+            xprop = XInternAtom(FbTk::App::instance()->display(), xpropstr.c_str(), False);
+
+        if (prop != XPROP && regstr == "[current]")
+            kind = CURRENT;
+        else if (prop == HEAD && regstr == "[mouse]")
+            kind = MOUSE_HEAD;
+        else if (isNumeric(prop) && parseNumber(regstr, number))
+            kind = NUMBER;
+    }
+
+    bool matchString(const FbTk::FbString &str) const {
+        return regexp.match(str);
+    }
 
-        xprop = XInternAtom(FbTk::App::instance()->display(), xpropstr.c_str(), False);
+    bool matchNumber(long number) const {
+        char buf[FbTk::StringUtil::NUMBER_CHARS];
+        *FbTk::StringUtil::number2Chars(buf, buf + sizeof(buf) - 1, number) = '\0';
+        return regexp.match(buf);
     }
 
     // (title=.*bar) or (@FOO=.*bar)
@@ -163,16 +201,46 @@ struct ClientPattern::Term {
     FbTk::RegExp regexp;       // compiled version of '.*bar'
     WinProperty prop;
     bool negate;
+    Kind kind;
+    int number;                // value of regstr for NUMBER
 };
 
+ClientPattern::Properties::Properties():
+    m_have_text(0),
+    m_have_number(0) { }
+
+const FbTk::FbString &ClientPattern::Properties::text(WinProperty prop) {
+    if (!(m_have_text & (1 << prop))) {
+        if (isNumeric(prop)) {
+            int n = number(prop);
+            m_text[prop].clear();
+            if (n >= 0)
+                FbTk::StringUtil::appendNumber(m_text[prop], n);
+        } else
+            m_text[prop] = fetchText(prop);
+        m_have_text |= 1 << prop;
+    }
+    return m_text[prop];
+}
+
+int ClientPattern::Properties::number(WinProperty prop) {
+    if (!(m_have_number & (1 << prop))) {
+        m_number[prop] = fetchNumber(prop);
+        m_have_number |= 1 << prop;
+    }
+    return m_number[prop];
+}
+
 ClientPattern::ClientPattern():
     m_matchlimit(0),
-    m_nummatches(0) {}
+    m_nummatches(0),
+    m_dependencies(0) {}
 
 // parse the given pattern (to end of line)
 ClientPattern::ClientPattern(const char *str):
     m_matchlimit(0),
-    m_nummatches(0)
+    m_nummatches(0),
+    m_dependencies(0)
 {
     /* A rough grammar of a pattern is:
        PATTERN ::= MATCH+ LIMIT?
@@ -278,6 +346,7 @@ ClientPattern::ClientPattern(const char *str):
 
     if (had_error) {
         FbTk::STLUtil::destroyAndClear(m_terms);
+        m_dependencies = 0;
     }
 }
 
@@ -303,14 +372,14 @@ string ClientPattern::toString() const {
 
     if (m_matchlimit > 0) {
         result.append(" {");
-        result.append(FbTk::StringUtil::number2String(m_matchlimit));
+        FbTk::StringUtil::appendNumber(result, m_matchlimit);
         result.append("}");
     }
     return result;
 }
 
 // does this client match this pattern?
-bool ClientPattern::match(const Focusable &win) const {
+bool ClientPattern::match(Properties &props) const {
     if (m_matchlimit != 0 && m_nummatches >= m_matchlimit)
         return false; // already matched out
 
@@ -322,29 +391,47 @@ bool ClientPattern::match(const Focusable &win) const {
     for (; it != it_end; ++it) {
         const Term& term = *(*it);
         if (term.prop == XPROP) {
-            if (!term.negate ^ ((term.regexp.match(win.getTextProperty(term.xprop))) || term.regexp.match(FbTk::StringUtil::number2String(win.getCardinalProperty(term.xprop)))))
+            if (!term.negate ^ (term.matchString(props.xpropText(term.xprop)) ||
+                    term.matchNumber(props.xpropCardinal(term.xprop))))
                 return false;
-        } else if (term.regstr == "[current]") {
-            WinClient *focused = FocusControl::focusedWindow();
-            if (term.prop == WORKSPACE) {
-                if (!term.negate ^ (getProperty(term.prop, win) == FbTk::StringUtil::number2String(win.screen().currentWorkspaceID())))
-                    return false;
-            } else if (term.prop == WORKSPACENAME) {
-                const Workspace *w = win.screen().currentWorkspace();
-                if (!w || (!term.negate ^ (getProperty(term.prop, win) == w->name())))
-                    return false;
-            } else if (!focused || (!term.negate ^ (getProperty(term.prop, win) == getProperty(term.prop, *focused))))
+            continue;
+        }
+
+        switch (term.kind) {
+        case Term::CURRENT: {
+            FbTk::FbString current;
+            if (!props.current(term.prop, current) ||
+                (!term.negate ^ (props.text(term.prop) == current)))
                 return false;
-        } else if (term.prop == HEAD && term.regstr == "[mouse]") {
-            if (!term.negate ^ (getProperty(term.prop, win) == FbTk::StringUtil::number2String(win.screen().getCurrHead())))
+            break;
+        }
+        case Term::MOUSE_HEAD:
+            if (!term.negate ^ (props.number(HEAD) == props.mouseHead()))
                 return false;
-
-        } else if (!term.negate ^ term.regexp.match(getProperty(term.prop, win)))
-            return false;
+            break;
+        case Term::NUMBER:
+            if (!term.negate ^ (props.number(term.prop) == term.number))
+                return false;
+            break;
+        default:
+            if (!term.negate ^ term.matchString(props.text(term.prop)))
+                return false;
+            break;
+        }
     }
     return true;
 }
 
+bool ClientPattern::literalTerm(WinProperty prop, FbTk::FbString &value) const {
+    Terms::const_iterator it = m_terms.begin(), it_end = m_terms.end();
+    for (; it != it_end; ++it) {
+        if ((*it)->prop == prop && (*it)->kind == Term::REGEXP && !(*it)->negate &&
+            (*it)->regexp.literal(value))
+            return true;
+    }
+    return false;
+}
+
 bool ClientPattern::dependsOnFocusedWindow() const {
     Terms::const_iterator it = m_terms.begin(), it_end = m_terms.end();
     for (; it != it_end; ++it) {
@@ -378,6 +465,7 @@ bool ClientPattern::addTerm(const FbTk::FbString &str, WinProperty prop, bool ne
 
     if ((rc = !term->regexp.error())) {
         m_terms.push_back(term);
+        m_dependencies |= 1 << prop;
     } else {
         delete term;
     }
@@ -385,87 +473,6 @@ bool ClientPattern::addTerm(const FbTk::FbString &str, WinProperty prop, bool ne
     return rc;
 }
 
-FbTk::FbString ClientPattern::getProperty(WinProperty prop, const Focusable &client) {
-
-    FbTk::FbString result;
-
-    // we need this for some of the window properties
-    const FluxboxWindow *fbwin = client.fbwindow();
-
-    switch (prop) {
-    case TITLE:
-        result = client.title().logical();
-        break;
-    case CLASS:
-        result = client.getWMClassClass();
-        break;
-    case ROLE:
-        result = client.getWMRole();
-        break;
-    case TRANSIENT:
-        result = client.isTransient() ? "yes" : "no";
-        break;
-    case MAXIMIZED:
-        result = (fbwin && fbwin->isMaximized()) ? "yes" : "no";
-        break;
-    case MINIMIZED:
-        result = (fbwin && fbwin->isIconic()) ? "yes" : "no";
-        break;
-    case SHADED:
-        result = (fbwin && fbwin->isShaded()) ? "yes" : "no";
-        break;
-    case STUCK:
-        result = (fbwin && fbwin->isStuck()) ? "yes" : "no";
-        break;
-    case FOCUSHIDDEN:
-        result = (fbwin && fbwin->isFocusHidden()) ? "yes" : "no";
-        break;
-    case ICONHIDDEN:
-        result = (fbwin && fbwin->isIconHidden()) ? "yes" : "no";
-        break;
-    case WORKSPACE: {
-        unsigned int wsnum = (fbwin ? fbwin->workspaceNumber() : client.screen().currentWorkspaceID());
-        result = FbTk::StringUtil::number2String(wsnum);
-        break;
-    }
-    case WORKSPACENAME: {
-        const Workspace *w = (fbwin ?
-                client.screen().getWorkspace(fbwin->workspaceNumber()) :
-                client.screen().currentWorkspace());
-        if (w) {
-            result = w->name();
-        }
-        break;
-    }
-    case HEAD:
-        if (fbwin) {
-            result = FbTk::StringUtil::number2String(client.screen().getHead(fbwin->fbWindow()));
-        }
-        break;
-    case LAYER:
-        if (fbwin) {
-            result = ::ResourceLayer::getString(fbwin->layerNum());
-        }
-        break;
-    case URGENT:
-        result = Fluxbox::instance()->attentionHandler()
-                .isDemandingAttention(client) ? "yes" : "no";
-        break;
-    case SCREEN:
-        result = FbTk::StringUtil::number2String(client.screen().screenNumber());
-        break;
-
-    case XPROP:
-        break;
-
-    case NAME:
-    default:
-        result = client.getWMClassName();
-        break;
-    }
-    return result;
-}
-
 bool ClientPattern::operator ==(const ClientPattern &pat) const {
     // we require the terms to be identical (order too)
     Terms::const_iterator it = m_terms.begin();
@@ -28,6 +28,7 @@
 #include "FbTk/NotCopyable.hh"
 #include "FbTk/FbString.hh"
 
+#include <X11/Xlib.h>
 #include <list>
 
 class Focusable;
@@ -58,8 +59,47 @@ public:
         XPROP
     };
 
+    /**
+     * The properties of one window, as seen by the terms of a pattern.
+     * Every value is fetched on first use and then kept, so one instance
+     * can be matched against any number of patterns.
+     */
+    class Properties {
+    public:
+        Properties();
+        virtual ~Properties() { }
+
+        const FbTk::FbString &text(WinProperty prop);
+        /// value of WORKSPACE, HEAD or SCREEN, -1 if there is none
+        int number(WinProperty prop);
+
+        /**
+         * value of the property for '[current]', which is the current
+         * workspace for WORKSPACE(NAME) and the focused window otherwise
+         * @return false if there is no such value
+         */
+        virtual bool current(WinProperty prop, FbTk::FbString &value) = 0;
+        /// head the mouse is on, for '(head=[mouse])'
+        virtual int mouseHead() = 0;
+        virtual FbTk::FbString xpropText(Atom prop) = 0;
+        virtual long xpropCardinal(Atom prop) = 0;
+
+    protected:
+        /// not called for WORKSPACE, HEAD or SCREEN
+        virtual FbTk::FbString fetchText(WinProperty prop) = 0;
+        /// only called for WORKSPACE, HEAD or SCREEN
+        virtual int fetchNumber(WinProperty prop) = 0;
+
+    private:
+        FbTk::FbString m_text[XPROP];
+        int m_number[XPROP];
+        unsigned int m_have_text, m_have_number;
+    };
+
     /// Does this client match this pattern?
     bool match(const Focusable &win) const;
+    /// Does the window with these properties match this pattern?
+    bool match(Properties &props) const;
 
     /// Does this pattern depend on the focused window?
     bool dependsOnFocusedWindow() const;
@@ -67,6 +107,16 @@ public:
     /// Does this pattern depend on the current workspace?
     bool dependsOnCurrentWorkspace() const;
 
+    /**
+     * Is there a term that only matches one exact value of the property?
+     * Windows with any other value can not match the pattern.
+     * @param value receives the value, if there is such a term
+     */
+    bool literalTerm(WinProperty prop, FbTk::FbString &value) const;
+
+    /// bitwise-or of (1 << prop) for every property the terms look at
+    unsigned int dependencies() const { return m_dependencies; }
+
     /**
      * Add an expression to match against
      * @param str is a regular expression
@@ -100,6 +150,7 @@ private:
     Terms m_terms; ///< our pattern is made up of a sequence of terms, currently we "and" them all
     int m_matchlimit;
     int m_nummatches;
+    unsigned int m_dependencies;
 };
 
 #endif // CLIENTPATTERN_HH
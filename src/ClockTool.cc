@@ -68,7 +68,7 @@ int showSeconds(const std::string& fmt_string) {
 }
 
 
-timeval calcNextTimeout(const std::string& fmt_string) {
+timeval calcNextTimeout(bool show_seconds) {
     timeval now;
     timeval next;
     gettimeofday(&now, 0);
@@ -80,7 +80,7 @@ timeval calcNextTimeout(const std::string& fmt_string) {
     }
 
     // wake up at next second-change
-    if (showSeconds(fmt_string)) {
+    if (show_seconds) {
         next.tv_sec = 0;
     }
 
@@ -167,6 +167,10 @@ ClockTool::ClockTool(const FbTk::FbWindow &parent,
     m_pixmap(0),
     m_timeformat(screen.resourceManager(), std::string("%k:%M"),
                  screen.name() + ".strftimeFormat", screen.altName() + ".StrftimeFormat"),
+    m_show_seconds(false),
+    m_format_changed(false),
+    m_toolbar_hidden(false),
+    m_item_hidden(false),
     m_stringconvertor(FbTk::StringConvertor::ToFbString) {
     // attach signals
     m_tracker.join(theme.reconfigSig(), FbTk::MemFun(*this, &ClockTool::themeReconfigured));
@@ -180,12 +184,10 @@ ClockTool::ClockTool(const FbTk::FbWindow &parent,
 
     _FB_USES_NLS;
 
-    m_timer.setTimeout(calcNextTimeout(*m_timeformat));
-
     FbTk::RefCount<FbTk::Command<void> > update_graphic(new FbTk::SimpleCommand<ClockTool>(*this,
                                                                                     &ClockTool::updateTime));
     m_timer.setCommand(update_graphic);
-    m_timer.start();
+    startTimer();
 
     m_button.setGC(m_theme->textGC());
 
@@ -226,10 +228,82 @@ void ClockTool::moveResize(int x, int y,
 
 void ClockTool::show() {
     m_button.show();
+    setHidden(m_item_hidden, false);
 }
 
 void ClockTool::hide() {
     m_button.hide();
+    setHidden(m_item_hidden, true);
+}
+
+void ClockTool::parentHidden(bool hidden) {
+    setHidden(m_toolbar_hidden, hidden);
+}
+
+void ClockTool::setHidden(bool &flag, bool hidden) {
+    if (hidden == flag)
+        return;
+
+    flag = hidden;
+    if (isHidden())
+        m_timer.stop();
+    else
+        updateTime(); // the time went on meanwhile, this restarts the timer
+}
+
+void ClockTool::parseFormat() {
+    if (m_parsed_format == *m_timeformat)
+        return;
+
+    m_parsed_format = *m_timeformat;
+    m_show_seconds = showSeconds(m_parsed_format);
+    m_segments.clear();
+
+    // a conversion is '%', any flags, width or E/O modifier and one char
+    const std::string &fmt = m_parsed_format;
+    std::string literal;
+    size_t i = 0;
+    while (i < fmt.size()) {
+        if (fmt[i] != '%' || i + 1 == fmt.size()) {
+            literal += fmt[i++];
+            continue;
+        }
+        if (fmt[i + 1] == '%') {
+            literal += '%';
+            i += 2;
+            continue;
+        }
+        size_t end = fmt.find_first_not_of("_-0^#123456789EO", i + 1);
+        if (end == std::string::npos) { // no conversion char, keep it as is
+            literal.append(fmt, i, std::string::npos);
+            break;
+        }
+
+        if (!literal.empty()) {
+            Segment seg = { false, "", literal, m_stringconvertor.recode(literal) };
+            m_segments.push_back(seg);
+            literal.clear();
+        }
+        Segment seg = { true, fmt.substr(i, end + 1 - i), "", "" };
+        m_segments.push_back(seg);
+        i = end + 1;
+    }
+    if (!literal.empty()) {
+        Segment seg = { false, "", literal, m_stringconvertor.recode(literal) };
+        m_segments.push_back(seg);
+    }
+    m_format_changed = true;
+}
+
+void ClockTool::startTimer() {
+    parseFormat();
+
+    // a running timer is restarted by the timer loop with the new
+    // timeout, stopping it here would break the loop when we are
+    // called from within the timeout itself
+    m_timer.setTimeout(calcNextTimeout(m_show_seconds));
+    if (!isHidden() && !m_timer.isTiming())
+        m_timer.start();
 }
 
 void ClockTool::setTimeFormat(const std::string &format) {
@@ -283,7 +357,7 @@ void ClockTool::updateTime() {
     gettimeofday(&now, 0);
     time_t the_time = now.tv_sec;
 
-    m_timer.setTimeout(calcNextTimeout(*m_timeformat));
+    startTimer();
 
     if (the_time != -1) {
         char time_string[255];
@@ -293,16 +367,38 @@ void ClockTool::updateTime() {
             return;
 
 #ifdef HAVE_STRFTIME
-        time_string_len = strftime(time_string, 255, m_timeformat->c_str(), time_type);
-        if( time_string_len == 0)
+        // only the conversions change, and most of them only once a
+        // minute or less, so nothing is recoded if they didn't change
+        bool changed = m_format_changed;
+        m_format_changed = false;
+        size_t total_len = 0;
+        std::vector<Segment>::iterator it = m_segments.begin();
+        for (; it != m_segments.end(); ++it) {
+            if (it->conversion) {
+                // an empty result, like %p in some locales, is valid here
+                time_string_len = strftime(time_string, sizeof(time_string),
+                                           it->format.c_str(), time_type);
+                if (it->text.compare(0, std::string::npos,
+                                     time_string, time_string_len) != 0) {
+                    it->text.assign(time_string, time_string_len);
+                    it->shown = m_stringconvertor.recode(it->text);
+                    changed = true;
+                }
+            }
+            total_len += it->text.size();
+        }
+        if (total_len == 0 || !changed)
             return;
-        std::string text = m_stringconvertor.recode(time_string);
+
+        FbTk::FbString text;
+        for (it = m_segments.begin(); it != m_segments.end(); ++it)
+            text.append(it->shown);
         if (m_button.text().logical() == text)
             return;
 
         m_button.setText(text);
 
-        unsigned int new_width = m_theme->font().textWidth(time_string, time_string_len) + 2;
+        unsigned int new_width = m_theme->font().textWidth(text.c_str(), text.size()) + 2;
         if (new_width > m_button.width()) {
             resize(new_width, m_button.height());
             resizeSig().emit();
@@ -32,6 +32,8 @@
 #include "FbTk/Timer.hh"
 #include "FbTk/FbString.hh"
 
+#include <vector>
+
 class ToolTheme;
 class BScreen;
 
@@ -64,9 +66,17 @@ public:
     void setOrientation(FbTk::Orientation orient);
 
     void parentMoved() { m_button.parentMoved(); }
+    void parentHidden(bool hidden);
 
 private:
     void updateTime();
+    /// (re)starts the timer for the next change of the shown time
+    void startTimer();
+    /// splits the time format into m_segments if it changed
+    void parseFormat();
+    /// sets one of the hidden flags, stops or restarts the timer
+    void setHidden(bool &flag, bool hidden);
+    bool isHidden() const { return m_toolbar_hidden || m_item_hidden; }
     void themeReconfigured();
     void renderTheme(int alpha);
     void reRender();
@@ -80,6 +90,20 @@ private:
     FbTk::Timer m_timer;
 
     FbTk::Resource<std::string> m_timeformat;
+    /// a literal run of the time format or one strftime conversion
+    struct Segment {
+        bool conversion;     ///< format is passed to strftime
+        std::string format;  ///< "%H", unused for literal runs
+        std::string text;    ///< the last strftime output or the literal
+        FbTk::FbString shown; ///< text recoded for the button
+    };
+
+    std::string m_parsed_format; ///< the format m_segments is from
+    std::vector<Segment> m_segments;
+    bool m_show_seconds;
+    bool m_format_changed; ///< m_segments weren't shown yet
+    bool m_toolbar_hidden; ///< the toolbar is hidden, see parentHidden()
+    bool m_item_hidden;    ///< the clock itself is hidden, see hide()
 
     FbTk::StringConvertor m_stringconvertor;
 
@@ -22,98 +22,45 @@
 
 #include "FbMenuParser.hh"
 
-#include "FbTk/StringUtil.hh"
-
 bool FbMenuParser::open(const std::string &filename) {
-    m_file.open(filename.c_str());
-    m_curr_pos = 0;
-    m_row = 0;
     m_curr_token = DONE;
-    return isLoaded();
+    return m_tokenizer.open(filename);
 }
 
 FbTk::Parser &FbMenuParser::operator >> (FbTk::Parser::Item &out) {
-    if (eof()) {        
+    if (eof()) {
         out = FbTk::Parser::s_empty_item;
-        return *this; 
+        return *this;
     }
 
-    if (m_curr_line.empty())
-        m_curr_token = DONE; // try next line
-
-    char first = '[';
-    char second = ']';
-
-    switch (m_curr_token) {
-    case TYPE:
-        first = '[';
-        second = ']';
-        break;
-    case NAME:
-        first = '(';
-        second = ')';
-        break;
-    case ARGUMENT:
-        first = '{';
-        second = '}';
-        break;
-    case ICON:
-        first = '<';
-        second = '>';
-        break;
-    case DONE: // get new line and call this again
-        if (!nextLine()) {
+    // get a new line if the current one is used up
+    while (m_curr_token == DONE || m_tokenizer.line().empty()) {
+        if (!m_tokenizer.nextLine()) {
             out = FbTk::Parser::s_empty_item;
             return *this;
         }
-        return (*this)>>out;
-        break;
+        m_curr_token = TYPE;
     }
-    
-    std::string key;
-    int err = FbTk::StringUtil::
-        getStringBetween(key, m_curr_line.c_str() + m_curr_pos,
-                         first, second);
-    if (err <= 0) {        
-        if (m_curr_token == TYPE)
-            m_curr_token = NAME;
-        else if (m_curr_token == NAME)
-            m_curr_token = ARGUMENT;
-        else if (m_curr_token == ARGUMENT)
-            m_curr_token = ICON;
-        else if (m_curr_token == ICON)
-            m_curr_token = DONE;
 
+    static const char delimiters[][2] = {
+        { '[', ']' }, // TYPE
+        { '(', ')' }, // NAME
+        { '{', '}' }, // ARGUMENT
+        { '<', '>' }  // ICON
+    };
+    static const char *names[] = { "TYPE", "NAME", "ARGUMENT", "ICON" };
+
+    Object token = m_curr_token;
+    m_curr_token = static_cast<Object>(m_curr_token + 1);
+
+    FbTk::Token value;
+    if (!m_tokenizer.between(delimiters[token][0], delimiters[token][1], value)) {
         out = FbTk::Parser::s_empty_item;
         return *this;
     }
 
-    m_curr_pos += err; // update current position in current line
-
-    // set value
-    out.second = key;
-
-    // set type and next token to be read
-    switch (m_curr_token) {
-    case TYPE:
-        out.first = "TYPE";
-        m_curr_token = NAME;
-        break;
-    case NAME:
-        out.first = "NAME";
-        m_curr_token = ARGUMENT;
-        break;
-    case ARGUMENT:
-        out.first = "ARGUMENT";
-        m_curr_token = ICON;
-        break;
-    case ICON:
-        out.first = "ICON";
-        m_curr_token = DONE;
-        break;
-    case DONE:
-        break;
-    }
+    out.first = names[token];
+    value.assignTo(out.second);
     return *this;
 }
 
@@ -122,14 +69,3 @@ FbTk::Parser::Item FbMenuParser::nextItem() {
     (*this)>>item;
     return item;
 }
-
-bool FbMenuParser::nextLine() {
-    if (!std::getline(m_file, m_curr_line))
-        return false;
-
-    m_row++;
-    m_curr_pos = 0;
-    m_curr_token = TYPE;
-
-    return true;
-}
@@ -24,32 +24,25 @@
 #define FBMENUPARSER_HH
 
 #include "FbTk/Parser.hh"
-
-#include <fstream>
+#include "FbTk/Tokenizer.hh"
 
 class FbMenuParser: public FbTk::Parser {
 public:
-    FbMenuParser():m_row(0), m_curr_pos(0), m_curr_token(TYPE) {}
-    FbMenuParser(const std::string &filename):m_row(0), m_curr_pos(0),
-                                              m_curr_token(TYPE) { open(filename); }
+    FbMenuParser(): m_curr_token(DONE) {}
+    FbMenuParser(const std::string &filename): m_curr_token(DONE) { open(filename); }
     ~FbMenuParser() { close(); }
 
     bool open(const std::string &filename);
-    void close() { m_file.close(); }
+    void close() { m_tokenizer.close(); }
     FbTk::Parser &operator >> (FbTk::Parser::Item &out);
     FbTk::Parser::Item nextItem();
 
-    bool isLoaded() const { return m_file.is_open(); }
-    bool eof() const { return m_file.eof(); }
-    int row() const { return m_row; }
-    std::string line() const { return m_curr_line; }
+    bool isLoaded() const { return m_tokenizer.isOpen(); }
+    bool eof() const { return m_tokenizer.eof(); }
+    int row() const { return m_tokenizer.row(); }
+    std::string line() const { return m_tokenizer.line().str(); }
 private:
-    bool nextLine();
-
-    mutable std::ifstream m_file;
-    int m_row;
-    int m_curr_pos;
-    std::string m_curr_line;
+    FbTk::Tokenizer m_tokenizer;
     enum Object {TYPE, NAME, ARGUMENT, ICON, DONE} m_curr_token;
 };
 
@@ -24,16 +24,163 @@
 #include "FileUtil.hh"
 #include "StringUtil.hh"
 
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#ifdef HAVE_SYS_INOTIFY_H
+#include "Timer.hh"
+
+#include <sys/inotify.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif // HAVE_SYS_INOTIFY_H
+
+namespace {
+
+#ifdef HAVE_SYS_INOTIFY_H
+
+const uint32_t WATCH_MASK = IN_ATTRIB | IN_MODIFY | IN_CLOSE_WRITE |
+                            IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                            IN_DELETE_SELF | IN_MOVE_SELF;
+
+/// what changes a tracked directory, the same its ctime tells about:
+/// entries coming and going, and the directory itself
+const uint32_t DIR_ENTRY_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+const uint32_t DIR_SELF_MASK = IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF;
+
+/// flag to set on events of a watch. name is empty for a watch on the file
+/// itself, otherwise it is the file to look for in the watched directory
+struct Watcher {
+    std::string name;
+    bool directory; ///< a tracked directory, writes to its files don't count
+    bool *changed;
+
+    bool matches(const inotify_event &ev) const {
+        if (ev.mask & IN_IGNORED)
+            return true;
+        if (!name.empty())
+            return ev.len > 0 && name == ev.name;
+        if (!directory)
+            return true;
+        return (ev.mask & (ev.len > 0 ? DIR_ENTRY_MASK : DIR_SELF_MASK)) != 0;
+    }
+};
+
+typedef std::multimap<int, Watcher> WatchMap;
+
+int s_inotify = -1;
+bool s_inotify_failed = false;
+WatchMap s_watches;
+
+/// reads all pending events and flags the files they belong to
+void readEvents() {
+    if (s_inotify < 0)
+        return;
+
+    long buffer[1024]; // long keeps inotify_event aligned
+    ssize_t len;
+    while ((len = read(s_inotify, buffer, sizeof(buffer))) > 0) {
+        const char *pos = reinterpret_cast<const char *>(buffer);
+        const char *end = pos + len;
+        while (pos < end) {
+            const inotify_event *ev = reinterpret_cast<const inotify_event *>(pos);
+            pos += sizeof(inotify_event) + ev->len;
+
+            if (ev->mask & IN_Q_OVERFLOW) {
+                // events got lost, so anything might have changed
+                WatchMap::iterator it = s_watches.begin();
+                for (; it != s_watches.end(); ++it)
+                    *it->second.changed = true;
+                continue;
+            }
+
+            std::pair<WatchMap::iterator, WatchMap::iterator> range =
+                s_watches.equal_range(ev->wd);
+            WatchMap::iterator it = range.first;
+            for (; it != range.second; ++it) {
+                if (it->second.matches(*ev))
+                    *it->second.changed = true;
+            }
+
+            // the kernel dropped the watch, the file or directory is gone
+            if (ev->mask & IN_IGNORED)
+                s_watches.erase(range.first, range.second);
+        }
+    }
+}
+
+bool initInotify() {
+    if (s_inotify >= 0)
+        return true;
+    if (s_inotify_failed)
+        return false;
+
+    s_inotify = inotify_init();
+    if (s_inotify < 0) {
+        s_inotify_failed = true;
+        return false;
+    }
+    fcntl(s_inotify, F_SETFL, fcntl(s_inotify, F_GETFL) | O_NONBLOCK);
+    fcntl(s_inotify, F_SETFD, FD_CLOEXEC);
+
+    FbTk::Timer::addInput(s_inotify, FbTk::RefCount<FbTk::Slot<void> >(
+                              new FbTk::SlotImpl<void (*)(), void>(&readEvents)));
+    return true;
+}
+
+bool addWatch(const std::string &path, const std::string &name,
+              bool directory, bool *changed) {
+    // the kernel keeps one mask per inode, so every watch asks for all
+    // events and the watchers pick theirs
+    int wd = inotify_add_watch(s_inotify, path.c_str(), WATCH_MASK);
+    if (wd < 0)
+        return false;
+    Watcher watcher = { name, directory, changed };
+    s_watches.insert(std::make_pair(wd, watcher));
+    return true;
+}
+
+void removeWatches(bool *changed) {
+    WatchMap::iterator it = s_watches.begin();
+    while (it != s_watches.end()) {
+        if (it->second.changed != changed) {
+            ++it;
+            continue;
+        }
+        int wd = it->first;
+        s_watches.erase(it++);
+        // other files might share the directory
+        if (s_watches.count(wd) == 0)
+            inotify_rm_watch(s_inotify, wd);
+    }
+}
+
+#endif // HAVE_SYS_INOTIFY_H
+
+} // end anonymous namespace
+
 namespace FbTk {
 
+AutoReloadHelper::~AutoReloadHelper() {
+    clear();
+}
+
 void AutoReloadHelper::checkReload() {
     if (!m_reload_cmd.get())
         return;
-    TimestampMap::const_iterator it = m_timestamps.begin();
-    TimestampMap::const_iterator it_end = m_timestamps.end();
+#ifdef HAVE_SYS_INOTIFY_H
+    // the main loop only gets to the events once the X queue is empty
+    readEvents();
+#endif // HAVE_SYS_INOTIFY_H
+    FileMap::const_iterator it = m_files.begin();
+    FileMap::const_iterator it_end = m_files.end();
     for (; it != it_end; ++it) {
-        if (FileUtil::getLastStatusChangeTimestamp(it->first.c_str()) !=
-            it->second) {
+        const Entry &entry = it->second;
+        if (entry.watched ? entry.changed :
+            FileUtil::getLastStatusChangeTimestamp(it->first.c_str()) !=
+            entry.timestamp) {
             reload();
             return;
         }
@@ -52,15 +199,68 @@ void AutoReloadHelper::addFile(const std::string& file) {
     if (file.empty())
         return;
     std::string expanded_file = StringUtil::expandFilename(file);
-    m_timestamps[expanded_file] = FileUtil::getLastStatusChangeTimestamp(expanded_file.c_str());
+#ifdef HAVE_SYS_INOTIFY_H
+    // whatever happened to the file so far is taken as read
+    readEvents();
+#endif // HAVE_SYS_INOTIFY_H
+    Entry &entry = m_files[expanded_file];
+    unwatch(entry);
+    watch(expanded_file, entry);
 }
 
 void AutoReloadHelper::reload() {
     if (!m_reload_cmd.get())
         return;
-    m_timestamps.clear();
+    clear();
     addFile(m_main_file);
     m_reload_cmd->execute();
 }
 
+void AutoReloadHelper::watch(const std::string &file, Entry &entry) {
+    entry.watched = false;
+    entry.changed = false;
+
+#ifdef HAVE_SYS_INOTIFY_H
+    if (initInotify()) {
+        std::string path(file);
+        while (path.size() > 1 && path[path.size() - 1] == '/')
+            path.erase(path.size() - 1);
+
+        std::string::size_type slash = path.rfind('/');
+        std::string dir = slash == std::string::npos ? "." :
+                          slash == 0 ? "/" : path.substr(0, slash);
+        std::string name = slash == std::string::npos ? path :
+                           path.substr(slash + 1);
+
+        // the directory tells about the file being created, replaced or
+        // removed, the watch on the file itself follows symlinks
+        if (addWatch(dir, name, false, &entry.changed)) {
+            entry.watched = addWatch(path, "", FileUtil::isDirectory(path.c_str()),
+                                     &entry.changed) ||
+                            errno == ENOENT;
+            if (!entry.watched)
+                removeWatches(&entry.changed);
+        }
+    }
+#endif // HAVE_SYS_INOTIFY_H
+
+    entry.timestamp = FileUtil::getLastStatusChangeTimestamp(file.c_str());
+}
+
+void AutoReloadHelper::unwatch(Entry &entry) {
+#ifdef HAVE_SYS_INOTIFY_H
+    if (entry.watched)
+        removeWatches(&entry.changed);
+#endif // HAVE_SYS_INOTIFY_H
+    entry.watched = false;
+}
+
+void AutoReloadHelper::clear() {
+    FileMap::iterator it = m_files.begin();
+    FileMap::iterator it_end = m_files.end();
+    for (; it != it_end; ++it)
+        unwatch(it->second);
+    m_files.clear();
+}
+
 } // end namespace FbTk
@@ -28,11 +28,22 @@
 
 #include "Command.hh"
 #include "RefCount.hh"
+#include "NotCopyable.hh"
 
 namespace FbTk {
 
-class AutoReloadHelper {
+/**
+ * Runs a reload command when one of the tracked files changed.
+ *
+ * Where inotify is available the files (and the directories holding them)
+ * are watched and changes are collected from the main loop, so checkReload
+ * does not have to stat every file. Files that can not be watched are
+ * checked by their status change timestamp instead.
+ */
+class AutoReloadHelper: private NotCopyable {
 public:
+    AutoReloadHelper() { }
+    ~AutoReloadHelper();
 
     void setMainFile(const std::string& filename);
     void addFile(const std::string& filename);
@@ -42,11 +53,22 @@ public:
     void reload();
 
 private:
+    struct Entry {
+        Entry(): timestamp(-1), watched(false), changed(false) { }
+        time_t timestamp;
+        bool watched; ///< changes are reported by inotify
+        bool changed; ///< set by inotify
+    };
+
+    void watch(const std::string &file, Entry &entry);
+    void unwatch(Entry &entry);
+    void clear();
+
     RefCount<Command<void> > m_reload_cmd;
     std::string m_main_file;
 
-    typedef std::map<std::string, time_t> TimestampMap;
-    TimestampMap m_timestamps;
+    typedef std::map<std::string, Entry> FileMap;
+    FileMap m_files;
 };
 
 } // end namespace FbTk
@@ -25,6 +25,7 @@
 #include "Transparent.hh"
 #include "FbWindow.hh"
 #include "TextUtils.hh"
+#include "Font.hh"
 
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
@@ -487,8 +488,10 @@ Pixmap FbPixmap::getRootPixmap(int screen_num, bool force_update) {
 }
 
 void FbPixmap::free() {
-    if (!m_dont_free && m_pm != 0)
+    if (!m_dont_free && m_pm != 0) {
+        Font::releaseDrawable(m_pm);
         XFreePixmap(display(), m_pm);
+    }
 
     /* note: m_dont_free shouldnt be required anywhere else,
        because then free() isn't being called appropriately! */
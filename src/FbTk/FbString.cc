@@ -49,6 +49,7 @@
 
 #include <iostream>
 #include <vector>
+#include <map>
 
 #ifndef HAVE_ICONV
 typedef int iconv_t;
@@ -104,29 +105,233 @@ FbTk::FbString makeVisualFromLogical(const FbTk::FbString& src) {
 
 #endif
 
+bool isAscii(const std::string &str) {
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] & 0x80)
+            return false;
+    }
+    return true;
+}
+
+/**
+   Recodes the text from one encoding to another
+   assuming cd is correct
+   @param cd the iconv type
+   @param ascii_compatible if cd leaves 7-bit ascii text as it is
+   @param in text to be converted
+   @param out where the converted text is appended to
+*/
+void recode(iconv_t cd, bool ascii_compatible,
+            const std::string &in, std::string &out) {
+
+#ifdef HAVE_ICONV
+/**
+  --NOTE--
+  In the "C" locale, this will strip any high-bit characters
+  because C means 7-bit ASCII charset. If you don't want this
+  then you need to set your locale to something UTF-8, OR something
+  ISO8859-1.
+*/
+
+    // If empty message, yes this can happen, return
+    if (in.empty())
+        return;
+
+    // most titles and labels are plain ascii, nothing to convert then
+    if (cd == ICONV_NULL || (ascii_compatible && isAscii(in))) {
+        out.append(in);
+        return;
+    }
+
+    // reuse the allocated memory, like makeVisualFromLogical()
+    static std::vector<char> buffer;
+    if (buffer.size() < in.size())
+        buffer.resize(in.size());
+
+    char* out_ptr = &buffer[0];
+    size_t outbytesleft = buffer.size();
+    size_t inbytesleft = in.size();
+
+#ifdef HAVE_CONST_ICONV
+    const char* in_ptr = in.data();
+#else
+    char* in_ptr = const_cast<char*>(in.data());
+#endif
+    size_t result = (size_t)(-1);
+    bool again = true;
+
+    while (again) {
+        again = false;
+
+        result = iconv(cd, &in_ptr, &inbytesleft, &out_ptr, &outbytesleft);
+
+        if (result == (size_t)(-1)) {
+            switch(errno) {
+            case EILSEQ:
+                // Try skipping a byte
+                in_ptr++;
+                inbytesleft--;
+                again = true;
+            case EINVAL:
+                break;
+            case E2BIG: {
+                // need more space!
+                size_t used = out_ptr - &buffer[0];
+                buffer.resize(buffer.size() + in.size());
+                out_ptr = &buffer[0] + used;
+                outbytesleft = buffer.size() - used;
+                again = true;
+                break;
+            }
+            default:
+                // something else broke
+                perror("iconv");
+                break;
+            }
+        }
+    }
+
+    out.append(&buffer[0], out_ptr - &buffer[0]);
+
+    // reset the conversion descriptor
+    iconv(cd, NULL, NULL, NULL, NULL);
+#else
+    out.append(in);
+#endif // HAVE_ICONV
+}
+
+std::string recode(iconv_t cd, bool ascii_compatible, const std::string &in) {
+    std::string out;
+    recode(cd, ascii_compatible, in, out);
+    return out;
+}
+
+/// @return true if cd converts all 7-bit ascii characters to themselves
+bool asciiCompatible(iconv_t cd) {
+    std::string ascii;
+    for (int c = 1; c < 0x80; ++c)
+        ascii += static_cast<char>(c);
+    return recode(cd, false, ascii) == ascii;
+}
+
 } // end of anonymous namespace
 
 
 namespace FbTk {
 
+#ifdef HAVE_FRIBIDI
+
+struct BiDiString::Visual {
+    FbString text;
+    unsigned int refs;
+};
+
+namespace {
+
+typedef std::map<FbString, BiDiString::Visual> VisualStore;
+
+// never destroyed, static BiDiStrings may outlive it otherwise
+VisualStore &visualStore() {
+    static VisualStore *store = new VisualStore;
+    return *store;
+}
+
+/// @return true if the utf-8 text has characters that fribidi reorders
+bool hasRightToLeft(const FbString& text) {
+
+    for (size_t i = 0; i < text.size(); ) {
+        unsigned char c = text[i];
+        if (c < 0x80) {
+            ++i;
+            continue;
+        }
+
+        unsigned int cp;
+        size_t len;
+        if (c >= 0xF0) {
+            cp = c & 0x07;
+            len = 4;
+        } else if (c >= 0xE0) {
+            cp = c & 0x0F;
+            len = 3;
+        } else {
+            cp = c & 0x1F;
+            len = 2;
+        }
+        for (size_t j = 1; j < len && i + j < text.size(); ++j)
+            cp = (cp << 6) | (text[i + j] & 0x3F);
+        i += len;
+
+        if ((cp >= 0x0590 && cp <= 0x08FF) ||   // hebrew, arabic, syriac ...
+            cp == 0x200F ||                     // right-to-left mark
+            (cp >= 0x202A && cp <= 0x202E) ||   // embeddings and overrides
+            (cp >= 0x2066 && cp <= 0x2069) ||   // isolates
+            (cp >= 0xFB1D && cp <= 0xFDFF) ||   // presentation forms
+            (cp >= 0xFE70 && cp <= 0xFEFF) ||
+            (cp >= 0x10800 && cp <= 0x10FFF) ||
+            (cp >= 0x1E800 && cp <= 0x1EFFF))
+            return true;
+    }
+    return false;
+}
+
+} // end anonymous namespace
+
+#endif // HAVE_FRIBIDI
+
 BiDiString::BiDiString(const FbString& logical) 
 #ifdef HAVE_FRIBIDI
-    : m_visual_dirty(false)
+    : m_visual(0), m_visual_dirty(false)
 #endif
 {
     if (!logical.empty())
         setLogical(logical);
 }
 
+#ifdef HAVE_FRIBIDI
+
+BiDiString::BiDiString(const BiDiString& other):
+    m_logical(other.m_logical),
+    m_visual(other.m_visual),
+    m_visual_dirty(other.m_visual_dirty) {
+
+    if (m_visual)
+        ++m_visual->refs;
+}
+
+BiDiString::~BiDiString() {
+    releaseVisual();
+}
+
+BiDiString& BiDiString::operator = (const BiDiString& other) {
+    if (this != &other) {
+        if (other.m_visual)
+            ++other.m_visual->refs;
+        releaseVisual();
+        m_logical = other.m_logical;
+        m_visual = other.m_visual;
+        m_visual_dirty = other.m_visual_dirty;
+    }
+    return *this;
+}
+
+void BiDiString::releaseVisual() const {
+    if (m_visual && --m_visual->refs == 0)
+        visualStore().erase(m_logical);
+    m_visual = 0;
+}
+
+#endif // HAVE_FRIBIDI
+
 const FbString& BiDiString::setLogical(const FbString& logical) {
-    m_logical = logical;
 #if HAVE_FRIBIDI
-    if (m_logical.empty()) {
-        m_visual_dirty = false;
-        m_visual.clear();
-    } else {
-        m_visual_dirty = true;
-    }
+    if (logical == m_logical)
+        return m_logical;
+    releaseVisual();
+    m_logical = logical;
+    m_visual_dirty = !m_logical.empty();
+#else
+    m_logical = logical;
 #endif
     return m_logical;
 }
@@ -134,10 +339,20 @@ const FbString& BiDiString::setLogical(const FbString& logical) {
 const FbString& BiDiString::visual() const {
 #if HAVE_FRIBIDI
     if (m_visual_dirty) {
-        m_visual = ::makeVisualFromLogical(logical());
+        m_visual_dirty = false;
+        if (hasRightToLeft(m_logical)) {
+            VisualStore &store = visualStore();
+            VisualStore::iterator it = store.find(m_logical);
+            if (it == store.end()) {
+                it = store.insert(std::make_pair(m_logical, Visual())).first;
+                it->second.text = ::makeVisualFromLogical(m_logical);
+                it->second.refs = 0;
+            }
+            m_visual = &it->second;
+            ++m_visual->refs;
+        }
     }
-    m_visual_dirty = false;
-    return m_visual;
+    return m_visual ? m_visual->text : m_logical;
 #else
     return m_logical;
 #endif
@@ -157,6 +372,7 @@ enum ConvType {
 
 static bool s_inited = false;
 static iconv_t s_iconv_convs[CONVSIZE];
+static bool s_ascii_compatible[CONVSIZE];
 static std::string s_locale_codeset;
 
 /// Initialise all of the iconv conversion descriptors
@@ -186,6 +402,9 @@ void init() {
     s_iconv_convs[X2FB] = iconv_open("UTF-8", "ISO8859-1");
     s_iconv_convs[FB2LOCALE] = iconv_open(s_locale_codeset.c_str(), "UTF-8");
     s_iconv_convs[LOCALE2FB] = iconv_open("UTF-8", s_locale_codeset.c_str());
+
+    for (int i = 0; i < CONVSIZE; ++i)
+        s_ascii_compatible[i] = asciiCompatible(s_iconv_convs[i]);
 #else
     memset(s_iconv_convs, 0, sizeof(s_iconv_convs));
 #endif // HAVE_ICONV
@@ -207,108 +426,38 @@ void shutdown() {
 
 
 
-/**
-   Recodes the text from one encoding to another
-   assuming cd is correct
-   @param cd the iconv type
-   @param msg text to be converted, **NOT** necessarily NULL terminated
-   @param size number of BYTES to convert
-   @return the recoded string, or 0 on failure
-*/
-std::string recode(iconv_t cd, const std::string &in) {
-
-#ifdef HAVE_ICONV
-/**
-  --NOTE--
-  In the "C" locale, this will strip any high-bit characters
-  because C means 7-bit ASCII charset. If you don't want this
-  then you need to set your locale to something UTF-8, OR something
-  ISO8859-1.
-*/
-
-    // If empty message, yes this can happen, return
-    if (in.empty())
-        return "";
-
-    if (cd == ICONV_NULL)
-        return in; // can't convert
-
-    size_t insize = in.size();
-    size_t outsize = insize;
-    std::vector<char> out(outsize);
-    char* out_ptr = &out[0];
-
-    size_t inbytesleft = insize;
-    size_t outbytesleft = outsize;
-
-#ifdef HAVE_CONST_ICONV
-    const char* in_ptr = in.data();
-#else
-    char* in_ptr = const_cast<char*>(in.data());
-#endif
-    size_t result = (size_t)(-1);
-    bool again = true;
-
-    while (again) {
-        again = false;
-
-        result = iconv(cd, &in_ptr, &inbytesleft, &out_ptr, &outbytesleft);
-
-        if (result == (size_t)(-1)) {
-            switch(errno) {
-            case EILSEQ:
-                // Try skipping a byte
-                in_ptr++;
-                inbytesleft--;
-                again = true;
-            case EINVAL:
-                break;
-            case E2BIG:
-                // need more space!
-                outsize += insize;
-                out.resize(outsize);
-                if (out.capacity() != outsize)
-                    again = true;
-                outbytesleft += insize;
-                out_ptr = (&out[0] + outsize) - outbytesleft;
-                break;
-            default:
-                // something else broke
-                perror("iconv");
-                break;
-            }
-        }
-    }
-
-    // copy to our return string
-    std::string ret;
-    ret.append(&out[0], outsize - outbytesleft);
-
-    // reset the conversion descriptor
-    iconv(cd, NULL, NULL, NULL, NULL);
+FbString XStrToFb(const std::string &src) {
+    return recode(s_iconv_convs[X2FB], s_ascii_compatible[X2FB], src);
+}
 
-    return ret;
-#else
-    return in;
-#endif // HAVE_ICONV
+std::string FbStrToX(const FbString &src) {
+    return recode(s_iconv_convs[FB2X], s_ascii_compatible[FB2X], src);
 }
 
-FbString XStrToFb(const std::string &src) {
-    return recode(s_iconv_convs[X2FB], src);
+void XStrToFb(const std::string &src, FbString &dest) {
+    recode(s_iconv_convs[X2FB], s_ascii_compatible[X2FB], src, dest);
 }
 
-std::string FbStrToX(const FbString &src) {
-    return recode(s_iconv_convs[FB2X], src);
+void FbStrToX(const FbString &src, std::string &dest) {
+    recode(s_iconv_convs[FB2X], s_ascii_compatible[FB2X], src, dest);
 }
 
 
 /// Handle thislocale string encodings (strings coming from userspace)
 FbString LocaleStrToFb(const std::string &src) {
-    return recode(s_iconv_convs[LOCALE2FB], src);
+    return recode(s_iconv_convs[LOCALE2FB], s_ascii_compatible[LOCALE2FB], src);
 }
 
 std::string FbStrToLocale(const FbString &src) {
-    return recode(s_iconv_convs[FB2LOCALE], src);
+    return recode(s_iconv_convs[FB2LOCALE], s_ascii_compatible[FB2LOCALE], src);
+}
+
+void LocaleStrToFb(const std::string &src, FbString &dest) {
+    recode(s_iconv_convs[LOCALE2FB], s_ascii_compatible[LOCALE2FB], src, dest);
+}
+
+void FbStrToLocale(const FbString &src, std::string &dest) {
+    recode(s_iconv_convs[FB2LOCALE], s_ascii_compatible[FB2LOCALE], src, dest);
 }
 
 bool haveUTF8() {
@@ -324,7 +473,8 @@ bool haveUTF8() {
 } // end namespace StringUtil
 
 #ifdef HAVE_ICONV
-StringConvertor::StringConvertor(EncodingTarget target) : m_iconv(ICONV_NULL) {
+StringConvertor::StringConvertor(EncodingTarget target) :
+    m_iconv(ICONV_NULL), m_ascii_compatible(true) {
     if (target == ToLocaleStr)
         m_destencoding = FbStringUtil::s_locale_codeset;
     else
@@ -353,6 +503,7 @@ bool StringConvertor::setSource(const std::string &encoding) {
         if (m_iconv != ICONV_NULL)
             iconv_close(m_iconv);
         m_iconv = newiconv;
+        m_ascii_compatible = asciiCompatible(m_iconv);
         return true;
     }
 #else
@@ -362,17 +513,26 @@ bool StringConvertor::setSource(const std::string &encoding) {
 
 FbString StringConvertor::recode(const std::string &src) {
 #ifdef HAVE_ICONV
-    return FbStringUtil::recode(m_iconv, src);
+    return ::recode(m_iconv, m_ascii_compatible, src);
 #else
     return src;
 #endif
 }
 
+void StringConvertor::recode(const std::string &src, FbString &dest) {
+#ifdef HAVE_ICONV
+    ::recode(m_iconv, m_ascii_compatible, src, dest);
+#else
+    dest.append(src);
+#endif
+}
+
 void StringConvertor::reset() {
 #ifdef HAVE_ICONV
     if (m_iconv != ICONV_NULL)
         iconv_close(m_iconv);
     m_iconv = ICONV_NULL;
+    m_ascii_compatible = true;
 #endif
 }
 
@@ -43,16 +43,30 @@ class BiDiString {
 public:
 
     BiDiString(const FbString& logical = FbString());
+#ifdef HAVE_FRIBIDI
+    BiDiString(const BiDiString& other);
+    ~BiDiString();
+    BiDiString& operator = (const BiDiString& other);
+#endif
 
     const FbString& logical() const { return m_logical; }
     const FbString& visual() const;
 
     const FbString& setLogical(const FbString& logical);
 
+#ifdef HAVE_FRIBIDI
+    // Visual forms are shared by all BiDiStrings with the same logical
+    // text, the same title usually sits in a frame label, an iconbar
+    // button and a menu at the same time.
+    struct Visual;
+#endif
+
 private:
     FbString m_logical;
 #ifdef HAVE_FRIBIDI
-    mutable FbString m_visual;
+    void releaseVisual() const;
+
+    mutable Visual *m_visual; ///< 0 if the text has no right-to-left parts
     mutable bool m_visual_dirty;
 #endif
 };
@@ -68,10 +82,16 @@ void shutdown();
 // NOTE: X "STRING" types are defined (ICCCM) as ISO Latin-1 encoding
 FbString XStrToFb(const std::string &src);
 std::string FbStrToX(const FbString &src);
+/// appends the converted src to dest
+void XStrToFb(const std::string &src, FbString &dest);
+void FbStrToX(const FbString &src, std::string &dest);
 
 /// Handle thislocale string encodings (strings coming from userspace)
 FbString LocaleStrToFb(const std::string &src);
 std::string FbStrToLocale(const FbString &src);
+/// appends the converted src to dest
+void LocaleStrToFb(const std::string &src, FbString &dest);
+void FbStrToLocale(const FbString &src, std::string &dest);
 
 bool haveUTF8();
 
@@ -89,10 +109,13 @@ public:
     void reset();
 
     FbString recode(const FbString &src);
+    /// appends the recoded src to dest
+    void recode(const std::string &src, FbString &dest);
 
 private:
 #ifdef HAVE_ICONV
     iconv_t m_iconv;
+    bool m_ascii_compatible; ///< m_iconv leaves 7-bit ascii text as it is
 #endif
     std::string m_destencoding;
 };
@@ -27,6 +27,7 @@
 #include "Color.hh"
 #include "App.hh"
 #include "Transparent.hh"
+#include "Font.hh"
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -143,8 +144,10 @@ FbWindow::~FbWindow() {
     if (m_window != 0) {
         // so we don't get any dangling eventhandler for this window
         FbTk::EventManager::instance()->remove(m_window);
-        if (m_destroy)
+        if (m_destroy) {
+            Font::releaseDrawable(m_window);
             XDestroyWindow(display(), m_window);
+        }
     }
 
 }
@@ -407,8 +410,10 @@ FbWindow &FbWindow::operator = (Window win) {
 
 void FbWindow::setNew(Window win) {
 
-    if (m_window != 0 && m_destroy)
+    if (m_window != 0 && m_destroy) {
+        Font::releaseDrawable(m_window);
         XDestroyWindow(display(), m_window);
+    }
 
     m_window = win;
 
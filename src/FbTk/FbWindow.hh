@@ -200,7 +200,7 @@ public:
                              unsigned int height, unsigned int bw = 0);
 
     /// forces full background change, recalcing of alpha values if necessary
-    void updateBackground(bool only_if_alpha);
+    virtual void updateBackground(bool only_if_alpha);
 
     static void updatedAlphaBackground(int screen);
 
@@ -213,6 +213,14 @@ protected:
 
     void setDepth(unsigned int depth) { m_depth = depth; }
 
+    /// @return the background pixmap set last, ParentRelative or None
+    Pixmap lastBackgroundPixmap() const { return m_lastbg_pm; }
+    /// @return true if the background is a color, which is put in pixel
+    bool lastBackgroundColor(unsigned long &pixel) const {
+        pixel = m_lastbg_color;
+        return m_lastbg_color_set;
+    }
+
 private:
     /// sets new X window and destroys old
     void setNew(Window win);
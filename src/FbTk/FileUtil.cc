@@ -23,9 +23,15 @@
 
 #include <sys/stat.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdio.h>
 
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <algorithm>
 
 using std::ifstream;
 using std::ofstream;
@@ -42,6 +48,19 @@ time_t FileUtil::getLastStatusChangeTimestamp(const char* filename) {
         return (time_t)-1;
 }
 
+FileUtil::FileStamp FileUtil::getFileStamp(const char* filename) {
+    FileStamp stamp;
+    struct stat buf;
+    if (filename && !stat(filename, &buf)) {
+        stamp.mtime = buf.st_mtime;
+#ifdef HAVE_STRUCT_STAT_ST_MTIM
+        stamp.mtime_nsec = buf.st_mtim.tv_nsec;
+#endif // HAVE_STRUCT_STAT_ST_MTIM
+        stamp.size = buf.st_size;
+    }
+    return stamp;
+}
+
 bool FileUtil::isDirectory(const char* filename) {
     struct stat buf;
     if (!filename || stat(filename, &buf))
@@ -83,6 +102,119 @@ bool FileUtil::copyFile(const char* from, const char* to) {
     return false;
 }
 
+namespace {
+
+/// @return the file a symlink eventually points to, or 'filename' itself
+std::string resolveLinks(const char* filename) {
+#ifdef PATH_MAX
+    char buf[PATH_MAX];
+    if (realpath(filename, buf) != 0)
+        return buf;
+#endif // PATH_MAX
+    return filename;
+}
+
+/// @return true if the open file 'fd' has exactly the content of 'filename'
+bool sameContent(int fd, const char* filename) {
+    struct stat a, b;
+    if (fstat(fd, &a) || stat(filename, &b) || a.st_size != b.st_size)
+        return false;
+
+    int other = open(filename, O_RDONLY);
+    if (other < 0)
+        return false;
+
+    std::vector<char> buf_a(8192), buf_b(8192);
+    bool same = lseek(fd, 0, SEEK_SET) == 0;
+    while (same) {
+        ssize_t len = read(fd, &buf_a[0], buf_a.size());
+        if (len <= 0) {
+            same = (len == 0);
+            break;
+        }
+        ssize_t pos = 0;
+        while (pos < len) {
+            ssize_t got = read(other, &buf_b[pos], len - pos);
+            if (got <= 0)
+                break;
+            pos += got;
+        }
+        same = (pos == len && std::equal(buf_a.begin(), buf_a.begin() + len,
+                                         buf_b.begin()));
+    }
+    ::close(other);
+    return same;
+}
+
+} // end anonymous namespace
+
+std::string FileUtil::makeTempFile(const char* filename) {
+    std::string name = resolveLinks(filename) + ".XXXXXX";
+    std::vector<char> templ(name.begin(), name.end());
+    templ.push_back('\0');
+
+    int fd = mkstemp(&templ[0]);
+    if (fd < 0) {
+        cerr << "Can't create temporary file for '"<<filename<<"'."<<endl;
+        return "";
+    }
+    ::close(fd);
+    return &templ[0];
+}
+
+bool FileUtil::replaceFile(const char* tmpfile, const char* filename) {
+    std::string target = resolveLinks(filename);
+
+    int fd = open(tmpfile, O_RDWR);
+    if (fd < 0) {
+        unlink(tmpfile);
+        return false;
+    }
+
+    if (sameContent(fd, target.c_str())) {
+        ::close(fd);
+        unlink(tmpfile);
+        return true;
+    }
+
+    // mkstemp creates the file with 0600, keep what the user had
+    struct stat buf;
+    mode_t mode;
+    if (!stat(target.c_str(), &buf))
+        mode = buf.st_mode & 07777;
+    else {
+        mode = umask(0);
+        umask(mode);
+        mode = 0666 & ~mode;
+    }
+
+    bool ok = fchmod(fd, mode) == 0 && fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+    if (ok && rename(tmpfile, target.c_str()) == 0)
+        return true;
+
+    cerr << "Can't write file '"<<filename<<"'."<<endl;
+    unlink(tmpfile);
+    return false;
+}
+
+bool FileUtil::writeFile(const char* filename, const std::string &contents) {
+    std::string tmpfile = makeTempFile(filename);
+    if (tmpfile.empty())
+        return false;
+
+    ofstream out(tmpfile.c_str());
+    out << contents;
+    out.close();
+    if (out.fail()) {
+        cerr << "Can't write file '"<<filename<<"'."<<endl;
+        unlink(tmpfile.c_str());
+        return false;
+    }
+
+    return replaceFile(tmpfile.c_str(), filename);
+}
+
 Directory::Directory(const char *dir):m_dir(0),
 m_num_entries(0) {
     if (dir != 0)
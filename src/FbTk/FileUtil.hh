@@ -55,9 +55,42 @@ namespace FileUtil {
     /// @return -1 (failure)
     time_t getLastStatusChangeTimestamp(const char* filename);
 
+    /// modification time and size of a file, to notice changes even
+    /// within the same second
+    struct FileStamp {
+        FileStamp(): mtime(-1), mtime_nsec(0), size(0) { }
+        bool operator == (const FileStamp &other) const {
+            return mtime == other.mtime && mtime_nsec == other.mtime_nsec &&
+                size == other.size;
+        }
+        bool operator != (const FileStamp &other) const { return !(*this == other); }
+
+        time_t mtime; ///< -1 if there is no such file
+        long mtime_nsec; ///< 0 where stat doesn't have nanoseconds
+        off_t size;
+    };
+
+    /// @return stamp of the file, or an empty one if it doesn't exist
+    FileStamp getFileStamp(const char* filename);
+
     /// copies file 'from' to 'to'
     bool copyFile(const char* from, const char* to);
 
+    /// creates an empty temporary file next to the file 'filename' points
+    /// to, so it can replace it later with replaceFile()
+    /// @return name of the temporary file or "" (failure)
+    std::string makeTempFile(const char* filename);
+
+    /// syncs 'tmpfile' to disk and renames it over 'filename', keeping the
+    /// mode of the old file; if both have the same content, 'filename' is
+    /// left alone. 'tmpfile' is removed in any case.
+    /// @return true on success
+    bool replaceFile(const char* tmpfile, const char* filename);
+
+    /// atomically replaces 'filename' with 'contents'
+    /// @return true on success
+    bool writeFile(const char* filename, const std::string &contents);
+
 } // end of File namespace
 
 ///  Wrapper class for DIR * routines
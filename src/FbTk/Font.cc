@@ -123,13 +123,23 @@ void Font::shutdown() {
             delete font;
         }
     }
+#ifdef USE_XFT
+    XftFontImp::shutdown();
+#endif // USE_XFT
+}
+
+void Font::releaseDrawable(Drawable drawable) {
+#ifdef USE_XFT
+    XftFontImp::releaseDrawable(drawable);
+#endif // USE_XFT
 }
 
 Font::Font(const char *name):
     m_fontimp(0),
     m_shadow(false), m_shadow_color("black", DefaultScreen(App::instance()->display())),
     m_shadow_offx(2), m_shadow_offy(2),
-    m_halo(false), m_halo_color("white", DefaultScreen(App::instance()->display()))
+    m_halo(false), m_halo_color("white", DefaultScreen(App::instance()->display())),
+    m_revision(0)
 {
     // MB_CUR_MAX returns the size of a char in the current locale
     if (MB_CUR_MAX > 1) // more than one byte, then we're multibyte
@@ -162,6 +172,8 @@ bool Font::load(const string &name) {
     if (name.size() == 0)
         return false;
 
+    ++m_revision;
+
     StringMapIt lookup_entry;
     FontCacheIt cache_entry;
 
@@ -207,10 +219,19 @@ bool Font::load(const string &name) {
 
         std::string realname = *name_it;
 
+        // "xft:<name>" asks for Xft even with a XLFD name: its glyphs are
+        // rendered once into glyph sets on the server, for every
+        // orientation, where XFontImp rotates bitmaps on the client
+        bool want_xft = false;
+        if (realname.compare(0, 4, "xft:") == 0) {
+            realname.erase(0, 4);
+            want_xft = true;
+        }
+
 #ifdef USE_XFT
-        if ((*name_it)[0] != '-') {
+        if (want_xft || realname[0] != '-') {
 
-            if (*name_it == "__DEFAULT__")
+            if (realname == "__DEFAULT__")
                 realname = "monospace";
 
             tmp_font = new XftFontImp(0, s_utf8mode);
@@ -218,7 +239,7 @@ bool Font::load(const string &name) {
 #endif // USE_XFT
 
         if (!tmp_font) {
-            if (*name_it == "__DEFAULT__")
+            if (realname == "__DEFAULT__")
                 realname = "fixed";
 
 #ifdef USE_XMB
@@ -248,6 +269,10 @@ bool Font::load(const string &name) {
 }
 
 unsigned int Font::textWidth(const char* text, unsigned int size) const {
+    return m_fontimp->cachedTextWidth(text, size);
+}
+
+unsigned int Font::partialTextWidth(const char* text, unsigned int size) const {
     return m_fontimp->textWidth(text, size);
 }
 
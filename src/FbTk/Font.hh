@@ -45,6 +45,8 @@ public:
 
     /// called at FbTk::App destruction time, cleans up cache
     static void shutdown();
+    /// called before destroying a drawable that text may have been drawn to
+    static void releaseDrawable(Drawable drawable);
 
     /// @return true if multibyte is enabled, else false
     static bool multibyte() { return s_multibyte; }
@@ -62,13 +64,16 @@ public:
     */
     bool load(const std::string &name);
 
-    void setHalo(bool flag)   { m_halo = flag; if (m_halo) setShadow(false); }
-    void setHaloColor(const Color& color) { m_halo_color = color; }
+    void setHalo(bool flag)   { m_halo = flag; if (m_halo) setShadow(false); ++m_revision; }
+    void setHaloColor(const Color& color) { m_halo_color = color; ++m_revision; }
 
-    void setShadow(bool flag) { m_shadow = flag; if (m_shadow) setHalo(false); }
-    void setShadowColor(const Color& color) { m_shadow_color = color; }
-    void setShadowOffX(int offx) { m_shadow_offx = offx; }
-    void setShadowOffY(int offy) { m_shadow_offy = offy; }
+    void setShadow(bool flag) { m_shadow = flag; if (m_shadow) setHalo(false); ++m_revision; }
+    void setShadowColor(const Color& color) { m_shadow_color = color; ++m_revision; }
+    void setShadowOffX(int offx) { m_shadow_offx = offx; ++m_revision; }
+    void setShadowOffY(int offy) { m_shadow_offy = offy; ++m_revision; }
+
+    /// changes whenever the font is loaded or its effects are changed
+    unsigned int revision() const { return m_revision; }
 
     /**
        @param text text to check size
@@ -79,6 +84,10 @@ public:
     unsigned int textWidth(const BiDiString &text) const {
         return textWidth(text.visual().c_str(), text.visual().size());
     }
+    /// textWidth() without the width cache, for parts of a string like
+    /// the ones tried while looking for where to cut it. They would push
+    /// the whole labels out of the cache.
+    unsigned int partialTextWidth(const char* text, unsigned int size) const;
 
     unsigned int height() const;
     int ascent() const;
@@ -129,6 +138,7 @@ private:
     int m_shadow_offy; ///< offset x for shadow
     bool m_halo; ///< halo text
     Color m_halo_color; ///< halo color
+    unsigned int m_revision; ///< see revision()
 };
 
 } //end namespace FbTk
@@ -0,0 +1,71 @@
+// FontImp.cc for FbTk
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "FontImp.hh"
+
+namespace {
+
+// a few menus and a toolbar worth of labels
+const size_t MAX_WIDTHS = 256;
+
+} // end anonymous namespace
+
+namespace FbTk {
+
+FontImp::FontImp():
+    m_width_hits(0), m_width_misses(0) {
+}
+
+unsigned int FontImp::cachedTextWidth(const char* text, unsigned int len) const {
+
+    std::string key(text, len);
+    WidthIndex::iterator it = m_width_index.find(key);
+    if (it != m_width_index.end()) {
+        ++m_width_hits;
+        m_widths.splice(m_widths.begin(), m_widths, it->second);
+        return it->second->second;
+    }
+
+    ++m_width_misses;
+    unsigned int width = textWidth(text, len);
+
+    if (m_widths.size() >= MAX_WIDTHS) {
+        m_width_index.erase(m_widths.back().first);
+        m_widths.pop_back();
+    }
+    m_widths.push_front(std::make_pair(key, width));
+    m_width_index[key] = m_widths.begin();
+
+    return width;
+}
+
+FontImp::WidthCacheStats FontImp::widthCacheStats() const {
+    WidthCacheStats stats = { m_width_hits, m_width_misses, m_widths.size() };
+    return stats;
+}
+
+void FontImp::clearWidthCache() {
+    m_widths.clear();
+    m_width_index.clear();
+}
+
+} // end namespace FbTk
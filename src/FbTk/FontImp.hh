@@ -27,6 +27,9 @@
 
 #include <X11/Xlib.h>
 
+#include <list>
+#include <map>
+
 namespace FbTk {
 
 class FbDrawable;
@@ -49,8 +52,29 @@ public:
     virtual bool loaded() const = 0;
     virtual void rotate(int angle) { } // by default, no rotate support
     virtual bool utf8() const { return false; };
+
+    /// textWidth(), remembered for the recently measured strings
+    unsigned int cachedTextWidth(const char* text, unsigned int len) const;
+
+    struct WidthCacheStats {
+        unsigned long hits, misses;
+        size_t entries;
+    };
+    WidthCacheStats widthCacheStats() const;
+
 protected:
-    FontImp() { }
+    FontImp();
+    /// forgets all measured widths, must be called when the font changes
+    void clearWidthCache();
+
+private:
+    // most recently used strings first
+    typedef std::list<std::pair<std::string, unsigned int> > Widths;
+    typedef std::map<std::string, Widths::iterator> WidthIndex;
+
+    mutable Widths m_widths;
+    mutable WidthIndex m_width_index;
+    mutable unsigned long m_width_hits, m_width_misses;
 };
 
 } // end namespace FbTk
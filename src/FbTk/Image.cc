@@ -20,6 +20,7 @@
 // DEALINGS IN THE SOFTWARE.
 
 #include "Image.hh"
+#include "PixmapWithMask.hh"
 #include "StringUtil.hh"
 #include "FileUtil.hh"
 
@@ -51,6 +52,63 @@ typedef std::list<std::string> StringList;
 ImageMap s_image_map;
 StringList s_search_paths;
 
+/// decoded images by file, screen and size
+struct CacheKey {
+    CacheKey(const std::string &path_, int screen_, unsigned int width_,
+             unsigned int height_):
+        path(path_), screen(screen_), width(width_), height(height_) { }
+
+    bool operator < (const CacheKey &other) const {
+        if (screen != other.screen)
+            return screen < other.screen;
+        if (width != other.width)
+            return width < other.width;
+        if (height != other.height)
+            return height < other.height;
+        return path < other.path;
+    }
+
+    std::string path;
+    int screen;
+    unsigned int width, height;
+};
+
+struct CacheEntry {
+    FbTk::RefCount<const FbTk::PixmapWithMask> image;
+    time_t timestamp;
+    size_t bytes;
+    unsigned long last_use;
+};
+
+typedef std::map<CacheKey, CacheEntry> ImageCache;
+
+ImageCache s_cache;
+size_t s_cache_size = 8 * 1024 * 1024;
+unsigned long s_cache_uses = 0;
+FbTk::Image::CacheStats s_stats = { 0, 0, 0, 0 };
+
+/// filenames already found in the search path
+typedef std::map<std::string, std::string> LocatedMap;
+LocatedMap s_located;
+
+void removeCacheEntry(ImageCache::iterator it) {
+    s_stats.bytes -= it->second.bytes;
+    s_cache.erase(it);
+}
+
+/// drops the least recently used images until the cache fits its size
+void trimCache() {
+    while (s_stats.bytes > s_cache_size && s_cache.size() > 1) {
+        ImageCache::iterator oldest = s_cache.begin();
+        ImageCache::iterator it = s_cache.begin();
+        for (; it != s_cache.end(); ++it) {
+            if (it->second.last_use < oldest->second.last_use)
+                oldest = it;
+        }
+        removeCacheEntry(oldest);
+    }
+}
+
 #ifdef HAVE_IMLIB2
 FbTk::ImageImlib2 imlib2_loader;
 #endif
@@ -65,22 +123,102 @@ namespace FbTk {
 
 PixmapWithMask *Image::load(const string &filename, int screen_num) {
 
+    // the caller owns (and may change) the result, hand out a copy
+    RefCount<const PixmapWithMask> image = loadCached(filename, screen_num);
+    if (image.get() == 0)
+        return 0;
+
+    return new PixmapWithMask(*image);
+}
+
+RefCount<const PixmapWithMask> Image::loadCached(const string &filename,
+                                                 int screen_num,
+                                                 unsigned int width,
+                                                 unsigned int height) {
+
+    RefCount<const PixmapWithMask> image;
 
     if (filename.empty())
-        return NULL;
+        return image;
 
     // determine file ending
     string extension(StringUtil::toUpper(StringUtil::findExtension(filename)));
 
     // valid handle?
     if (s_image_map.find(extension) == s_image_map.end())
-        return NULL;
+        return image;
+
+    // the timestamp also tells if a remembered location is still valid
+    string path;
+    time_t timestamp = (time_t)-1;
+    LocatedMap::iterator located = s_located.find(filename);
+    if (located != s_located.end()) {
+        path = located->second;
+        timestamp = FileUtil::getLastStatusChangeTimestamp(path.c_str());
+    }
+    if (timestamp == (time_t)-1) {
+        path = locateFile(filename);
+        if (path.empty())
+            return image;
+        s_located[filename] = path;
+        timestamp = FileUtil::getLastStatusChangeTimestamp(path.c_str());
+    }
+
+    CacheKey key(path, screen_num, width, height);
+    ImageCache::iterator it = s_cache.find(key);
+    if (it != s_cache.end()) {
+        if (it->second.timestamp == timestamp) {
+            ++s_stats.hits;
+            it->second.last_use = ++s_cache_uses;
+            return it->second.image;
+        }
+        removeCacheEntry(it);
+    }
+
+    ++s_stats.misses;
+
+    if (width == 0 || height == 0) {
+        image.reset(s_image_map[extension]->load(path, screen_num));
+    } else {
+        // scale the cached original
+        RefCount<const PixmapWithMask> original = loadCached(path, screen_num);
+        if (original.get() != 0) {
+            PixmapWithMask *scaled = new PixmapWithMask(*original);
+            scaled->scale(width, height);
+            image.reset(scaled);
+        }
+    }
+
+    if (image.get() == 0)
+        return image;
 
-    string path = locateFile(filename);
-    if (!path.empty())
-        return s_image_map[extension]->load(path, screen_num);
+    CacheEntry &entry = s_cache[key];
+    entry.image = image;
+    entry.timestamp = timestamp;
+    // 32 bits per pixel plus a 1 bit mask
+    entry.bytes = image->width() * image->height() * 4 +
+        image->width() * image->height() / 8;
+    entry.last_use = ++s_cache_uses;
+    s_stats.bytes += entry.bytes;
+
+    trimCache();
+
+    return image;
+}
+
+Image::CacheStats Image::cacheStats() {
+    s_stats.entries = s_cache.size();
+    return s_stats;
+}
+
+void Image::setCacheSize(size_t bytes) {
+    s_cache_size = bytes;
+    trimCache();
+}
 
-    return 0;
+void Image::shutdown() {
+    s_cache.clear();
+    s_stats.bytes = 0;
 }
 
 string Image::locateFile(const string &filename) {
@@ -133,14 +271,17 @@ void Image::remove(ImageBase &base) {
 
 void Image::addSearchPath(const string &search_path) {
     s_search_paths.push_back(search_path);
+    s_located.clear();
 }
 
 void Image::removeSearchPath(const string &search_path) {
     s_search_paths.remove(search_path);
+    s_located.clear();
 }
 
 void Image::removeAllSearchPaths() {
     s_search_paths.clear();
+    s_located.clear();
 }
 
 } // end namespace FbTk
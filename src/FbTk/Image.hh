@@ -22,9 +22,12 @@
 #ifndef FBTK_IMAGE_HH
 #define FBTK_IMAGE_HH
 
+#include "RefCount.hh"
+
 #include <string>
 #include <list>
 #include <map>
+#include <cstddef>
 
 namespace FbTk {
 
@@ -36,6 +39,25 @@ namespace Image {
 
     /// @return an instance of PixmapWithMask on success, 0 on failure
     PixmapWithMask *load(const std::string &filename, int screen_num);
+    /// Loads an image through the decoded image cache. The image is shared
+    /// with every other user of the same file, so it must not be changed.
+    /// @param width,height scale the image to this size, 0 keeps the original
+    /// @return the image, or an empty handle on failure
+    RefCount<const PixmapWithMask> loadCached(const std::string &filename,
+                                              int screen_num,
+                                              unsigned int width = 0,
+                                              unsigned int height = 0);
+
+    struct CacheStats {
+        unsigned long hits, misses;
+        size_t entries, bytes;
+    };
+    /// @return counters of the decoded image cache
+    CacheStats cacheStats();
+    /// sets how many bytes of (estimated) pixmap memory the cache may hold
+    void setCacheSize(size_t bytes);
+    /// frees the cached images, must be called before the display is closed
+    void shutdown();
     /// for register file type and imagebase
     /// @return false on failure
     bool registerType(const std::string &type, ImageBase &base);
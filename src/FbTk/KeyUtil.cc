@@ -25,6 +25,7 @@
 #include <X11/keysym.h>
 
 #include <string>
+#include <algorithm>
 #ifdef HAVE_CSTRING
   #include <cstring>
 #else
@@ -112,6 +113,16 @@ void KeyUtil::loadModmap() {
             }
         }
     }
+
+    // numlock and scrolllock are often unmapped (zero) or share a
+    // modifier, so there are usually less than eight distinct combinations
+    m_lockmasks.clear();
+    for (int i = 0; i < 8; i++) {
+        unsigned int mask = (i & 1 ? LockMask : 0) |
+            (i & 2 ? m_numlock : 0) | (i & 4 ? m_scrolllock : 0);
+        if (std::find(m_lockmasks.begin(), m_lockmasks.end(), mask) == m_lockmasks.end())
+            m_lockmasks.push_back(mask);
+    }
 }
 
 
@@ -121,13 +132,11 @@ void KeyUtil::loadModmap() {
 */
 void KeyUtil::grabKey(unsigned int key, unsigned int mod, Window win) {
     Display *display = App::instance()->display();
-    const unsigned int nummod = instance().numlock();
-    const unsigned int scrollmod = instance().scrolllock();
+    const std::vector<unsigned int> &locks = instance().lockMasks();
 
     // Grab with numlock, capslock and scrlock
-    for (int i = 0; i < 8; i++) {
-        XGrabKey(display, key, mod | (i & 1 ? LockMask : 0) |
-                 (i & 2 ? nummod : 0) | (i & 4 ? scrollmod : 0),
+    for (size_t i = 0; i < locks.size(); i++) {
+        XGrabKey(display, key, mod | locks[i],
                  win, True, GrabModeAsync, GrabModeAsync);
     }
 
@@ -136,19 +145,25 @@ void KeyUtil::grabKey(unsigned int key, unsigned int mod, Window win) {
 void KeyUtil::grabButton(unsigned int button, unsigned int mod, Window win,
                          unsigned int event_mask, Cursor cursor) {
     Display *display = App::instance()->display();
-    const unsigned int nummod = instance().numlock();
-    const unsigned int scrollmod = instance().scrolllock();
+    const std::vector<unsigned int> &locks = instance().lockMasks();
 
     // Grab with numlock, capslock and scrlock
-    for (int i = 0; i < 8; i++) {
-        XGrabButton(display, button, mod | (i & 1 ? LockMask : 0) |
-                    (i & 2 ? nummod : 0) | (i & 4 ? scrollmod : 0),
+    for (size_t i = 0; i < locks.size(); i++) {
+        XGrabButton(display, button, mod | locks[i],
                     win, False, event_mask, GrabModeAsync, GrabModeAsync,
                     None, cursor);
     }
 
 }
 
+void KeyUtil::ungrabKey(unsigned int key, unsigned int mod, Window win) {
+    Display *display = App::instance()->display();
+    const std::vector<unsigned int> &locks = instance().lockMasks();
+
+    for (size_t i = 0; i < locks.size(); i++)
+        XUngrabKey(display, key, mod | locks[i], win);
+}
+
 /**
  @return keycode of keystr on success else 0
 */
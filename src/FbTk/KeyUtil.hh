@@ -25,6 +25,7 @@
 #include <X11/Xlib.h>
 
 #include <memory>
+#include <vector>
 
 namespace FbTk {
 
@@ -44,6 +45,11 @@ public:
     static void grabButton(unsigned int button, unsigned int mod, Window win,
                            unsigned int event_mask, Cursor cursor = None);
 
+    /**
+       Ungrab a single key grabbed with grabKey
+    */
+    static void ungrabKey(unsigned int key, unsigned int mod, Window win);
+
     /**
        convert the string to the keysym
        @return the keysym corresponding to the string, or zero
@@ -88,11 +94,18 @@ public:
     int capslock() const { return LockMask; }
     int scrolllock() const { return m_scrolllock; }
 
+    /**
+       every distinct combination of the lock modifiers we ignore;
+       each grab has to be issued once per entry
+    */
+    const std::vector<unsigned int> &lockMasks() const { return m_lockmasks; }
+
 private:
     void loadModmap();
 
     XModifierKeymap *m_modmap;
     int m_numlock, m_scrolllock;
+    std::vector<unsigned int> m_lockmasks;
     static std::auto_ptr<KeyUtil> s_keyutil;
 };
 
@@ -149,7 +149,8 @@ Menu::Menu(FbTk::ThemeProxy<MenuTheme> &tm, ImageControl &imgctrl):
 
     m_columns =
         m_rows_per_column =
-        m_min_columns = 0;
+        m_min_columns =
+        m_first_item = 0;
 
     FbTk::EventManager &evm = *FbTk::EventManager::instance();
     long event_mask = ButtonPressMask | ButtonReleaseMask |
@@ -355,6 +356,8 @@ void Menu::cycleItems(bool reverse) {
 }
 
 void Menu::setActiveIndex(int new_index) {
+    scrollToItem(new_index);
+
     // clear the items and close any open submenus
     int old_active_index = m_active_index;
     m_active_index = new_index;
@@ -378,6 +381,7 @@ void Menu::enterSubmenu() {
     if (submenu == 0)
         return;
 
+    submenu->populate();
     if (submenu->menuitems.size() == 0)
         return;
 
@@ -429,23 +433,45 @@ void Menu::updateMenu() {
         m_item_w = 1;
 
     if (!menuitems.empty()) {
-        m_columns = 1;
-
-        while (theme()->itemHeight() * (menuitems.size() + 1) / m_columns +
-               theme()->titleHeight() + theme()->borderWidth() > m_screen_height) {
-            m_columns++;
-        }
+        // the fewest columns for which
+        // itemHeight * (items + 1) / columns + titleHeight + borderWidth
+        // fits the screen height
+        const unsigned int total = theme()->itemHeight() * (menuitems.size() + 1);
+        const unsigned int decoration = theme()->titleHeight() + theme()->borderWidth();
+        if (decoration <= m_screen_height)
+            m_columns = total / (m_screen_height - decoration + 1) + 1;
+        else // nothing fits, one row
+            m_columns = menuitems.size();
+
+        // too wide for the screen, show as many columns as fit and
+        // scroll through the items
+        unsigned int max_columns = m_screen_width / m_item_w;
+        bool scroll = m_screen_width > 0 && decoration < m_screen_height &&
+                      static_cast<unsigned int>(m_columns) > max_columns;
+        if (scroll)
+            m_columns = max_columns > 0 ? max_columns : 1;
 
         if (m_columns < m_min_columns)
             m_columns = m_min_columns;
 
         m_rows_per_column = menuitems.size() / m_columns;
         if (menuitems.size() % m_columns) m_rows_per_column++;
+
+        if (scroll) {
+            // same as above: leave room for one more row
+            int rows = (m_screen_height - decoration) / theme()->itemHeight() - 1;
+            if (rows < 1)
+                rows = 1;
+            if (rows < m_rows_per_column)
+                m_rows_per_column = rows;
+        }
     } else {
         m_columns = 0;
         m_rows_per_column = 0;
     }
 
+    scrollTo(m_first_item);
+
     int itmp = (theme()->itemHeight() * m_rows_per_column);
     m_frame_h = itmp < 1 ? 1 : itmp;
 
@@ -528,9 +554,16 @@ void Menu::updateMenu() {
     m_shape->update();
 }
 
+void Menu::invalidate() {
+    m_need_update = true;
+    if (isVisible())
+        updateMenu();
+}
+
 
 void Menu::show() {
 
+    populate();
     if (isVisible() || menuitems.empty())
         return;
 
@@ -591,14 +624,16 @@ void Menu::clearWindow() {
     m_frame.clear();
 
     // clear foreground bits of frame items
-    for (size_t i = 0; i < menuitems.size(); i++) {
+    int last = std::min<int>(m_first_item + visibleItems(), menuitems.size());
+    for (int i = m_first_item; i < last; i++) {
         clearItem(i, false);   // no clear
     }
     m_shape->update();
 }
 
 void Menu::redrawFrame(FbDrawable &drawable) {
-    for (size_t i = 0; i < menuitems.size(); i++) {
+    int last = std::min<int>(m_first_item + visibleItems(), menuitems.size());
+    for (int i = m_first_item; i < last; i++) {
         drawItem(drawable, i);
     }
 
@@ -699,23 +734,18 @@ void Menu::drawSubmenu(unsigned int index) {
     if (item->submenu() && isVisible() && (! item->submenu()->isTorn()) &&
         item->isEnabled()) {
 
+        item->submenu()->populate();
+
         if (item->submenu()->m_parent != this)
             item->submenu()->m_parent = this;
 
         item->submenu()->setScreen(m_screen_x, m_screen_y, m_screen_width, m_screen_height);
 
-        // ensure we do not divide by 0 and thus cause a SIGFPE
-        if (m_rows_per_column == 0) {
-#if DEBUG
-            cerr << __FILE__ << "(" << __LINE__
-                 << ") Error: m_rows_per_column == 0 in FbTk::Menu::drawSubmenu()\n";
-#endif
+        int item_x, item_y;
+        if (!itemPosition(index, item_x, item_y))
             return;
-        }
 
-        int column = index / m_rows_per_column;
-        int row = index - (column * m_rows_per_column);
-        int new_x = x() + ((m_item_w * (column + 1)) + m_window.borderWidth());
+        int new_x = x() + item_x + m_item_w + m_window.borderWidth();
         int new_y;
 
         if (m_alignment == ALIGNTOP) {
@@ -723,7 +753,7 @@ void Menu::drawSubmenu(unsigned int index) {
                      ((item->submenu()->m_title_vis) ?
                       item->submenu()->theme()->titleHeight() + m_window.borderWidth() : 0));
         } else {
-            new_y = (y() + (theme()->itemHeight() * row) +
+            new_y = (y() + item_y +
                      ((m_title_vis) ? theme()->titleHeight() + m_window.borderWidth() : 0) -
                      ((item->submenu()->m_title_vis) ?
                       item->submenu()->theme()->titleHeight() + m_window.borderWidth() : 0));
@@ -780,19 +810,9 @@ int Menu::drawItem(FbDrawable &drawable, unsigned int index,
     MenuItem *item = menuitems[index];
     if (! item) return 0;
 
-    // ensure we do not divide by 0 and thus cause a SIGFPE
-    if (m_rows_per_column == 0) {
-#if DEBUG
-        cerr << __FILE__ << "(" << __LINE__
-             << ") Error: m_rows_per_column == 0 in FbTk::Menu::drawItem()\n";
-#endif
+    int item_x, item_y;
+    if (!itemPosition(index, item_x, item_y))
         return 0;
-    }
-
-    int column = index / m_rows_per_column;
-    int row = index - (column * m_rows_per_column);
-    int item_x = (column * m_item_w);
-    int item_y = (row * theme()->itemHeight());
 
     if (exclusive_drawable)
         item_x = item_y = 0;
@@ -887,9 +907,7 @@ void Menu::buttonPressEvent(XButtonEvent &be) {
 
     if (be.window == m_frame && m_item_w != 0) {
 
-        int column = (be.x / m_item_w);
-        int i = (be.y / theme()->itemHeight());
-        int w = (column * m_rows_per_column) + i;
+        int w = itemAt(be.x, be.y);
 
         if (validIndex(w) && isItemSelectable(static_cast<unsigned int>(w))) {
             MenuItem *item = menuitems[w];
@@ -928,13 +946,19 @@ void Menu::buttonReleaseEvent(XButtonEvent &re) {
 
     } else if (re.window == m_frame) {
 
-        int column = (re.x / m_item_w);
-        int i = (re.y / theme()->itemHeight());
-        int ix = column * m_item_w;
-        int iy = i * theme()->itemHeight();
-        int w = (column * m_rows_per_column) + i;
+        // the wheel scrolls menus that don't fit the screen
+        if ((re.button == 4 || re.button == 5) &&
+            visibleItems() < static_cast<int>(menuitems.size())) {
+            int step = std::max(1, m_rows_per_column / 2);
+            scrollTo(m_first_item + (re.button == 4 ? -step : step));
+            return;
+        }
 
-        if (validIndex(w) && isItemSelectable(static_cast<unsigned int>(w))) {
+        int w = itemAt(re.x, re.y);
+        int ix = 0, iy = 0;
+
+        if (validIndex(w) && itemPosition(w, ix, iy) &&
+            isItemSelectable(static_cast<unsigned int>(w))) {
             if (m_active_index == w && isItemEnabled(w) &&
                 re.x > ix && re.x < (signed) (ix + m_item_w) &&
                 re.y > iy && re.y < (signed) (iy + theme()->itemHeight())) {
@@ -974,9 +998,7 @@ void Menu::motionNotifyEvent(XMotionEvent &me) {
 
     } else if (!(me.state & Button1Mask) && me.window == m_frame) {
         stopHide();
-        int column = (me.x / m_item_w);
-        int i = (me.y / theme()->itemHeight());
-        int w = (column * m_rows_per_column) + i;
+        int w = itemAt(me.x, me.y);
 
         if (w == m_active_index || !validIndex(w))
             return;
@@ -1052,13 +1074,13 @@ void Menu::exposeEvent(XExposeEvent &ee) {
         int i, ii;
         for (i = column; i <= column_d; i++) {
             // set the iterator to the first item in the column needing redrawing
-            int index = id + i * m_rows_per_column;
+            int index = m_first_item + id + i * m_rows_per_column;
 
             if (index < static_cast<int>(menuitems.size()) && index >= 0) {
                 Menuitems::iterator it = menuitems.begin() + index;
                 Menuitems::iterator it_end = menuitems.end();
                 for (ii = id; ii <= id_d && it != it_end; ++it, ii++) {
-                    int index = ii + (i * m_rows_per_column);
+                    int index = m_first_item + ii + (i * m_rows_per_column);
                     // redraw the item
                     clearItem(index);
                 }
@@ -1266,24 +1288,12 @@ void Menu::renderForeground(FbWindow &win, FbDrawable &drawable) {
 // nothing in here should be rendered transparently
 // (unless you use a caching pixmap, which I think we should avoid)
 void Menu::clearItem(int index, bool clear, int search_index) {
-    if (!validIndex(index))
+    int item_x, item_y;
+    if (!validIndex(index) || !itemPosition(index, item_x, item_y))
         return;
 
-    // ensure we do not divide by 0 and thus cause a SIGFPE
-    if (m_rows_per_column == 0) {
-#if DEBUG
-        cerr << __FILE__ << "(" << __LINE__
-             << ") Error: m_rows_per_column == 0 in FbTk::Menu::clearItem()\n";
-#endif
-        return;
-    }
-
-    int column = index / m_rows_per_column;
-    int row = index - (column * m_rows_per_column);
     unsigned int item_w = m_item_w;
     unsigned int item_h = theme()->itemHeight();
-    int item_x = (column * item_w);
-    int item_y = (row * item_h);
     bool highlight = (index == m_active_index && isItemSelectable(index));
 
     if (search_index < 0)
@@ -1314,21 +1324,12 @@ void Menu::clearItem(int index, bool clear, int search_index) {
 // Area must have been cleared before calling highlight
 void Menu::highlightItem(int index) {
 
-    // ensure we do not divide by 0 and thus cause a SIGFPE
-    if (m_rows_per_column == 0) {
-#if DEBUG
-        cerr << __FILE__ << "(" << __LINE__
-             << ") Error: m_rows_per_column == 0 in FbTk::Menu::highlightItem()\n";
-#endif
+    int item_x, item_y;
+    if (!itemPosition(index, item_x, item_y))
         return;
-    }
 
-    int column = index / m_rows_per_column;
-    int row = index - (column * m_rows_per_column);
     unsigned int item_w = m_item_w;
     unsigned int item_h = theme()->itemHeight();
-    int item_x = (column * m_item_w);
-    int item_y = (row * item_h);
 
     FbPixmap buffer = FbPixmap(m_frame, item_w, item_h, m_frame.depth());
 
@@ -1377,25 +1378,82 @@ void Menu::drawTypeAheadItems() {
 
 // underline menuitem[index] with respect to matchstringsize size
 void Menu::drawLine(int index, int size){
-    if (!validIndex(index))
+    int item_x, item_y;
+    if (!validIndex(index) || !itemPosition(index, item_x, item_y))
         return;
 
+    FbTk::MenuItem *item = find(index);
+    item->drawLine(m_frame, theme(), size, item_x, item_y, m_item_w);
+}
+
+bool Menu::itemPosition(int index, int &item_x, int &item_y) const {
     // ensure we do not divide by 0 and thus cause a SIGFPE
     if (m_rows_per_column == 0) {
 #if DEBUG
         cerr << __FILE__ << "(" << __LINE__
-             << ") Error: m_rows_per_column == 0 in FbTk::Menu::drawLine()\n";
+             << ") Error: m_rows_per_column == 0 in FbTk::Menu::itemPosition()\n";
 #endif
+        return false;
+    }
+
+    int pos = index - m_first_item;
+    if (pos < 0 || pos >= visibleItems())
+        return false;
+
+    int column = pos / m_rows_per_column;
+    int row = pos - (column * m_rows_per_column);
+    item_x = (column * m_item_w);
+    item_y = (row * theme()->itemHeight());
+    return true;
+}
+
+int Menu::itemAt(int x, int y) const {
+    if (m_item_w == 0 || theme()->itemHeight() == 0)
+        return -1;
+
+    int column = (x / m_item_w);
+    int row = (y / theme()->itemHeight());
+    if (row >= m_rows_per_column)
+        return -1;
+
+    return m_first_item + (column * m_rows_per_column) + row;
+}
+
+void Menu::scrollTo(int first) {
+    int last_first = static_cast<int>(menuitems.size()) - visibleItems();
+    if (first > last_first)
+        first = last_first;
+    if (first < 0)
+        first = 0;
+
+    if (first == m_first_item)
         return;
+
+    m_first_item = first;
+
+    // a submenu would point at the wrong item now
+    if (validIndex(m_which_sub)) {
+        Menu *submenu = menuitems[m_which_sub]->submenu();
+        if (submenu && submenu->isVisible() && !submenu->isTorn())
+            submenu->internal_hide(false);
+        m_which_sub = -1;
+    }
+
+    if (isVisible() && !m_need_update) {
+        // the items are part of the background
+        m_frame.updateBackground(false);
+        clearWindow();
     }
+}
 
-    int column = index / m_rows_per_column;
-    int row = index - (column * m_rows_per_column);
-    int item_x = (column * m_item_w);
-    int item_y = (row * theme()->itemHeight());
+void Menu::scrollToItem(int index) {
+    if (!validIndex(index) || visibleItems() == 0)
+        return;
 
-    FbTk::MenuItem *item = find(index);
-    item->drawLine(m_frame, theme(), size, item_x, item_y, m_item_w);
+    if (index < m_first_item)
+        scrollTo(index);
+    else if (index >= m_first_item + visibleItems())
+        scrollTo(index - visibleItems() + 1);
 }
 
 void Menu::hideShownMenu() {
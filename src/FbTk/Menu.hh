@@ -111,6 +111,8 @@ public:
     /// move menu to x,y
     virtual void move(int x, int y);
     virtual void updateMenu();
+    /// an item changed its looks, redraw now if visible or else when shown
+    void invalidate();
     void setItemSelected(unsigned int index, bool val);
     void setItemEnabled(unsigned int index, bool val);
     void setMinimumColumns(int columns) { m_min_columns = columns; }
@@ -181,11 +183,26 @@ protected:
                  bool exclusive_drawable = false);
     void clearItem(int index, bool clear = true, int search_index = -1);
     void highlightItem(int index);
+    /// gets the position of item 'index' in the frame
+    /// @return false if the item isn't shown right now
+    bool itemPosition(int index, int &item_x, int &item_y) const;
+    /// @return index of the item at x, y in the frame (may be invalid)
+    int itemAt(int x, int y) const;
+    /// @return number of items shown at once
+    int visibleItems() const { return m_columns * m_rows_per_column; }
+    /// shows the items from 'first' on, if not all of them fit the screen
+    void scrollTo(int first);
+    /// scrolls so that item 'index' is shown
+    void scrollToItem(int index);
     virtual void redrawTitle(FbDrawable &pm);
     virtual void redrawFrame(FbDrawable &pm);
 
     virtual void internal_hide(bool first = true);
 
+    /// called before the menu gets shown, so derived menus can create
+    /// their items only once somebody looks at them
+    virtual void populate() { }
+
 private:
 
     void openSubmenu();
@@ -244,6 +261,9 @@ private:
     int m_columns;
     int m_rows_per_column;
     int m_min_columns;
+    // if the grid would be wider than the screen, it only shows
+    // visibleItems() items, starting with 'm_first_item'
+    int m_first_item;
 
     unsigned int m_item_w;
 
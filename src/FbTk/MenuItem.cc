@@ -28,10 +28,68 @@
 #include "App.hh"
 #include "StringUtil.hh"
 #include "Menu.hh"
+#include "Timer.hh"
 #include <X11/keysym.h>
 
+#include <set>
+
+namespace {
+
+/// number of icons loaded per event loop round, so the window manager
+/// stays responsive while a large menu gets its icons
+const size_t ICONS_PER_ROUND = 16;
+
+/// menu items waiting for their icons
+struct IconQueue {
+    IconQueue() {
+        timer.setTimeout(0, 1);
+        timer.fireOnce(true);
+    }
+
+    std::list<FbTk::MenuItem *> items;
+    FbTk::Timer timer;
+};
+
+IconQueue &iconQueue();
+
+void loadQueuedIcons() {
+    IconQueue &queue = iconQueue();
+
+    std::set<FbTk::Menu *> menus;
+    for (size_t i = 0; i < ICONS_PER_ROUND && !queue.items.empty(); ++i) {
+        FbTk::MenuItem *item = queue.items.front();
+        item->loadIcon(); // removes it from the queue
+        if (item->icon() != 0 && item->menu() != 0)
+            menus.insert(item->menu());
+    }
+
+    std::set<FbTk::Menu *>::iterator it = menus.begin();
+    for (; it != menus.end(); ++it)
+        (*it)->invalidate();
+
+    if (!queue.items.empty())
+        queue.timer.start();
+}
+
+IconQueue &iconQueue() {
+    // never destroyed, menu items may outlive any static object
+    static IconQueue *queue = 0;
+    if (queue == 0) {
+        queue = new IconQueue();
+        queue->timer.setFunctor(&loadQueuedIcons);
+    }
+    return *queue;
+}
+
+} // end anonymous namespace
+
 namespace FbTk {
 
+MenuItem::~MenuItem() {
+    if (m_icon.get() != 0 && m_icon->pending)
+        iconQueue().items.erase(m_icon->queue_pos);
+}
+
 void MenuItem::click(int button, int time, unsigned int mods) {
     if (m_command.get() != 0) {
         if (m_menu && m_close_on_click && (mods & ControlMask) == 0)
@@ -96,17 +154,28 @@ void MenuItem::draw(FbDrawable &draw,
     //
     if (draw_background) {
         if (icon() != 0) {
-            // copy pixmap, so we don't resize the original
-            FbPixmap tmp_pixmap, tmp_mask;
-            tmp_pixmap.copy(icon()->pixmap());
-            tmp_mask.copy(icon()->mask());
+            const unsigned int scale_size = height - 2*theme->bevelWidth();
+            const PixmapWithMask *scaled = icon();
+            RefCount<const PixmapWithMask> cached;
+            PixmapWithMask tmp;
 
             // scale pixmap to right size
-            if (height - 2*theme->bevelWidth() != tmp_pixmap.height()) {
-                unsigned int scale_size = height - 2*theme->bevelWidth();
-                tmp_pixmap.scale(scale_size, scale_size);
-                tmp_mask.scale(scale_size, scale_size);
+            if (scale_size != scaled->height()) {
+                if (m_icon.get() != 0 && scaled == m_icon->pixmap.get()) {
+                    // our own icon file, the image cache keeps it scaled
+                    cached = Image::loadCached(m_icon->filename,
+                                               theme->screenNum(),
+                                               scale_size, scale_size);
+                    scaled = cached.get();
+                } else {
+                    // copy pixmap, so we don't resize the original
+                    tmp = *scaled;
+                    tmp.scale(scale_size, scale_size);
+                    scaled = &tmp;
+                }
             }
+            const FbPixmap &tmp_pixmap = scaled != 0 ? scaled->pixmap() : tmp.pixmap();
+            const FbPixmap &tmp_mask = scaled != 0 ? scaled->mask() : tmp.mask();
 
             if (tmp_pixmap.drawable() != 0) {
                 GC gc = theme->frameTextGC().gc();
@@ -310,17 +379,39 @@ void MenuItem::draw(FbDrawable &draw,
 
 void MenuItem::setIcon(const std::string &filename, int screen_num) {
     if (filename.empty()) {
-        if (m_icon.get() != 0)
+        if (m_icon.get() != 0) {
+            if (m_icon->pending)
+                iconQueue().items.erase(m_icon->queue_pos);
             m_icon.reset(0);
+        }
         return;
     }
 
-    if (m_icon.get() == 0)
+    if (m_icon.get() == 0) {
         m_icon.reset(new Icon);
+        m_icon->pending = false;
+    }
 
     m_icon->filename = FbTk::StringUtil::expandFilename(filename);
-    m_icon->pixmap.reset(Image::load(m_icon->filename.c_str(),
-                         screen_num));
+    m_icon->screen_num = screen_num;
+    m_icon->pixmap = RefCount<const PixmapWithMask>();
+
+    if (!m_icon->pending) {
+        IconQueue &queue = iconQueue();
+        m_icon->queue_pos = queue.items.insert(queue.items.end(), this);
+        m_icon->pending = true;
+        if (!queue.timer.isTiming())
+            queue.timer.start();
+    }
+}
+
+void MenuItem::loadIcon() {
+    if (m_icon.get() == 0 || !m_icon->pending)
+        return;
+
+    iconQueue().items.erase(m_icon->queue_pos);
+    m_icon->pending = false;
+    m_icon->pixmap = Image::loadCached(m_icon->filename, m_icon->screen_num);
 }
 
 unsigned int MenuItem::height(const FbTk::ThemeProxy<MenuTheme> &theme) const {
@@ -330,16 +421,31 @@ unsigned int MenuItem::height(const FbTk::ThemeProxy<MenuTheme> &theme) const {
 unsigned int MenuItem::width(const FbTk::ThemeProxy<MenuTheme> &theme) const {
     // textwidth + bevel width on each side of the text
     const unsigned int icon_width = height(theme);
-    const unsigned int normal = theme->frameFont().textWidth(label()) +
+    const unsigned int normal = textWidth(theme) +
                                 2 * (theme->bevelWidth() + icon_width);
     return m_icon.get() == 0 ? normal : normal + icon_width;
 }
 
+unsigned int MenuItem::textWidth(const FbTk::ThemeProxy<MenuTheme> &theme) const {
+    const BiDiString &text = label();
+    if (!m_text_width_valid || m_measured_label != text.logical()) {
+        m_text_width = theme->frameFont().textWidth(text);
+        m_measured_label = text.logical();
+        m_text_width_valid = true;
+    }
+    return m_text_width;
+}
+
 void MenuItem::updateTheme(const FbTk::ThemeProxy<MenuTheme> &theme) {
-    if (m_icon.get() == 0)
+    // the font may have changed
+    m_text_width_valid = false;
+
+    // a queued icon gets loaded anyway
+    if (m_icon.get() == 0 || m_icon->pending)
         return;
 
-    m_icon->pixmap.reset(Image::load(m_icon->filename.c_str(), theme->screenNum()));
+    m_icon->screen_num = theme->screenNum();
+    m_icon->pixmap = Image::loadCached(m_icon->filename, theme->screenNum());
 
 
 }
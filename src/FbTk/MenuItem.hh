@@ -29,6 +29,7 @@
 #include "FbString.hh"
 
 #include <memory>
+#include <list>
 
 namespace FbTk {
 
@@ -47,7 +48,8 @@ public:
           m_enabled(true),
           m_selected(false),
           m_close_on_click(true),
-          m_toggle_item(false)
+          m_toggle_item(false),
+          m_text_width_valid(false)
     { }
     explicit MenuItem(const BiDiString &label)
         : m_label(label),
@@ -56,7 +58,8 @@ public:
           m_enabled(true),
           m_selected(false),
           m_close_on_click(true),
-          m_toggle_item(false)
+          m_toggle_item(false),
+          m_text_width_valid(false)
     { }
 
     MenuItem(const BiDiString &label, Menu &host_menu)
@@ -66,7 +69,8 @@ public:
           m_enabled(true),
           m_selected(false),
           m_close_on_click(true),
-          m_toggle_item(false)
+          m_toggle_item(false),
+          m_text_width_valid(false)
     { }
     /// create a menu item with a specific command to be executed on click
     MenuItem(const BiDiString &label, RefCount<Command<void> > &cmd, Menu *menu = 0)
@@ -77,7 +81,8 @@ public:
           m_enabled(true),
           m_selected(false),
           m_close_on_click(true),
-          m_toggle_item(false)
+          m_toggle_item(false),
+          m_text_width_valid(false)
     { }
 
     MenuItem(const BiDiString &label, Menu *submenu, Menu *host_menu = 0)
@@ -87,17 +92,25 @@ public:
           m_enabled(true),
           m_selected(false),
           m_close_on_click(true),
-          m_toggle_item(false)
+          m_toggle_item(false),
+          m_text_width_valid(false)
     { }
-    virtual ~MenuItem() { }
+    virtual ~MenuItem();
 
     void setCommand(RefCount<Command<void> > &cmd) { m_command = cmd; }
     virtual void setSelected(bool selected) { m_selected = selected; }
     virtual void setEnabled(bool enabled) { m_enabled = enabled; }
-    virtual void setLabel(const BiDiString &label) { m_label = label; }
+    virtual void setLabel(const BiDiString &label) {
+        m_label = label;
+        m_text_width_valid = false;
+    }
     virtual void setToggleItem(bool val) { m_toggle_item = val; }
     void setCloseOnClick(bool val) { m_close_on_click = val; }
+    /// sets the icon file, it is loaded in the background; the item
+    /// is drawn without icon until then
     void setIcon(const std::string &filename, int screen_num);
+    /// loads the icon set with setIcon() now, if it isn't loaded yet
+    void loadIcon();
     virtual Menu *submenu() { return m_submenu; }
     /**
         @name accessors
@@ -148,6 +161,9 @@ public:
     Menu *menu() { return m_menu; }
 
 private:
+    /// @return width of the label in the menu font, measured once per label
+    unsigned int textWidth(const FbTk::ThemeProxy<MenuTheme> &theme) const;
+
     BiDiString m_label; ///< label of this item
     Menu *m_menu; ///< the menu we live in
     Menu *m_submenu; ///< a submenu, 0 if we don't have one
@@ -156,9 +172,17 @@ private:
     bool m_close_on_click, m_toggle_item;
     int m_index;
 
+    // label() may be overridden, so the cache remembers what it measured
+    mutable bool m_text_width_valid;
+    mutable unsigned int m_text_width;
+    mutable FbString m_measured_label;
+
     struct Icon {
-        std::auto_ptr<PixmapWithMask> pixmap;
+        RefCount<const PixmapWithMask> pixmap; ///< shared with the image cache
         std::string filename;
+        int screen_num;
+        bool pending; ///< waiting in the load queue at queue_pos
+        std::list<MenuItem *>::iterator queue_pos;
     };
     std::auto_ptr<Icon> m_icon;
 
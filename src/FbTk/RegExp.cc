@@ -29,11 +29,55 @@
 
 #include <iostream>
 
+#ifdef HAVE_CSTRING
+  #include <cstring>
+#else
+  #include <string.h>
+#endif
+
 using std::string;
 
 #ifdef USE_REGEXP
 using std::cerr;
 using std::endl;
+
+namespace {
+
+const char SPECIAL[] = "\\^$.|?*+()[]{}";
+
+/// @return true if str ends with a ".*" that is not escaped
+bool endsWithAnything(const string &str) {
+    size_t size = str.size();
+    if (size < 2 || str[size - 2] != '.' || str[size - 1] != '*')
+        return false;
+    size_t backslashes = 0;
+    while (backslashes < size - 2 && str[size - 3 - backslashes] == '\\')
+        ++backslashes;
+    return backslashes % 2 == 0;
+}
+
+/**
+ * An expression without special characters (or with all of them
+ * escaped) only matches one string.
+ * @return true if str is such an expression, literal is the string
+ */
+bool unescapeLiteral(const string &str, string &literal) {
+    literal.clear();
+    for (size_t i = 0; i < str.size(); ++i) {
+        char c = str[i];
+        if (c == '\\') {
+            if (i + 1 == str.size() || !strchr(SPECIAL, str[i + 1]))
+                return false;
+            c = str[++i];
+        } else if (strchr(SPECIAL, c))
+            return false;
+        literal += c;
+    }
+    return true;
+}
+
+} // end anonymous namespace
+
 #endif // USE_REGEXP
 
 namespace FbTk {
@@ -42,7 +86,32 @@ namespace FbTk {
 // or just a substring. Substrings aren't supported if not HAVE_REGEXP
 RegExp::RegExp(const string &str, bool full_match):
 #ifdef USE_REGEXP
+m_kind(GENERAL),
 m_regex(0) {
+
+    // most patterns in the apps and keys files are plain names, maybe
+    // with a leading or trailing .*, those don't need the regex engine
+    string body = str;
+    bool any_before = !full_match;
+    bool any_after = !full_match;
+    while (body.compare(0, 2, ".*") == 0) {
+        body.erase(0, 2);
+        any_before = true;
+    }
+    while (endsWithAnything(body)) {
+        body.erase(body.size() - 2);
+        any_after = true;
+    }
+
+    if (unescapeLiteral(body, m_literal)) {
+        if (any_before)
+            m_kind = any_after ? SUBSTRING : SUFFIX;
+        else
+            m_kind = any_after ? PREFIX : LITERAL;
+        return;
+    }
+    m_literal.clear();
+
     string match;
     if (full_match) {
         match = "^";
@@ -74,8 +143,33 @@ RegExp::~RegExp() {
 
 bool RegExp::match(const string &str) const {
 #ifdef USE_REGEXP
+    return match(str.c_str());
+#else // notdef USE_REGEXP
+    return (m_str == str);
+#endif // USE_REGEXP
+}
+
+bool RegExp::match(const char *str) const {
+#ifdef USE_REGEXP
+    // like regexec, everything works on the string up to the first 0
+    switch (m_kind) {
+    case LITERAL:
+        return strcmp(str, m_literal.c_str()) == 0;
+    case PREFIX:
+        return strncmp(str, m_literal.c_str(), m_literal.size()) == 0;
+    case SUFFIX: {
+        size_t len = strlen(str);
+        return len >= m_literal.size() &&
+            strcmp(str + len - m_literal.size(), m_literal.c_str()) == 0;
+    }
+    case SUBSTRING:
+        return strstr(str, m_literal.c_str()) != 0;
+    case GENERAL:
+        break;
+    }
+
     if (m_regex)
-        return regexec(m_regex, str.c_str(), 0, 0, 0) == 0;
+        return regexec(m_regex, str, 0, 0, 0) == 0;
     else
         return false;
 #else // notdef USE_REGEXP
@@ -86,10 +180,21 @@ bool RegExp::match(const string &str) const {
 
 bool RegExp::error() const {
 #ifdef USE_REGEXP
-    return m_regex == 0;
+    return m_kind == GENERAL && m_regex == 0;
 #else
     return m_str == "";
 #endif // USE_REGEXP
 }
 
+bool RegExp::literal(string &str) const {
+#ifdef USE_REGEXP
+    if (m_kind != LITERAL)
+        return false;
+    str = m_literal;
+#else
+    str = m_str;
+#endif // USE_REGEXP
+    return true;
+}
+
 } // end namespace FbTk
@@ -49,11 +49,26 @@ public:
     ~RegExp();
 
     bool match(const std::string &str) const;
+    bool match(const char *str) const;
 
     bool error() const;
 
+    /// @return true if exactly one string matches, which is stored in str
+    bool literal(std::string &str) const;
+
 private:
 #ifdef USE_REGEXP
+    /// how match() works, decided once when the expression is compiled
+    enum Kind {
+        GENERAL,    ///< run regexec
+        LITERAL,    ///< "foo", compare the string
+        PREFIX,     ///< "foo.*"
+        SUFFIX,     ///< ".*foo"
+        SUBSTRING   ///< ".*foo.*"
+    };
+
+    Kind m_kind;
+    std::string m_literal; ///< the "foo" of all kinds but GENERAL
     regex_t* m_regex;
 #else // notdef USE_REGEXP
     std::string m_str;
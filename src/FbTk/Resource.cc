@@ -23,7 +23,9 @@
 #include "Resource.hh"
 #include "I18n.hh"
 #include "StringUtil.hh"
+#include "FileUtil.hh"
 
+#include <unistd.h>
 #include <iostream>
 #ifdef HAVE_CASSERT
   #include <cassert>
@@ -120,20 +122,17 @@ bool ResourceManager::save(const char *filename, const char *mergefilename) {
 
     // empty database
     XrmDatabaseHelper database;
-
-    string rc_string;
-    ResourceList::iterator i = m_resourcelist.begin();
-    ResourceList::iterator i_end = m_resourcelist.end();
-    //write all resources to database
-    for (; i != i_end; ++i) {
-        Resource_base *resource = *i;
-        rc_string = resource->name() + string(": ") + resource->getString();
-        XrmPutLineResource(&*database, rc_string.c_str());
-    }
+    put(*database);
 
     if (database==0)
         return false;
 
+    // write to a temporary file first, so a crash never leaves a
+    // truncated file behind
+    string tmpfile = FileUtil::makeTempFile(filename);
+    if (tmpfile.empty())
+        return false;
+
     //check if we want to merge a database
     if (mergefilename) {
         // force reload of file
@@ -146,22 +145,40 @@ bool ResourceManager::save(const char *filename, const char *mergefilename) {
 
         if (!m_database) {
             unlock();
+            unlink(tmpfile.c_str());
             return false;
         }
 
         XrmMergeDatabases(*database, &**m_database); // merge databases
-        XrmPutFileDatabase(**m_database, filename); // save database to file
+        XrmPutFileDatabase(**m_database, tmpfile.c_str()); // save database to file
 
         // don't try to destroy the database (XrmMergeDatabases destroys it)
         *database = 0;
         unlock();
     } else // save database to file
-        XrmPutFileDatabase(*database, filename);
+        XrmPutFileDatabase(*database, tmpfile.c_str());
+
+    if (!FileUtil::replaceFile(tmpfile.c_str(), filename))
+        return false;
 
     m_filename = filename;
     return true;
 }
 
+void ResourceManager::put(XrmDatabase &database) const {
+    string rc_string;
+    ResourceList::const_iterator i = m_resourcelist.begin();
+    ResourceList::const_iterator i_end = m_resourcelist.end();
+    //write all resources to database
+    for (; i != i_end; ++i) {
+        const Resource_base *resource = *i;
+        rc_string.assign(resource->name());
+        rc_string.append(": ");
+        rc_string.append(resource->getString());
+        XrmPutLineResource(&database, rc_string.c_str());
+    }
+}
+
 Resource_base *ResourceManager::findResource(const string &resname) {
    // find resource name
     ResourceList::iterator i = m_resourcelist.begin();
@@ -93,6 +93,9 @@ public:
     /// @return true on success
     virtual bool save(const char *filename, const char *mergefilename=0);
 
+    /// Put all resources registered to this class into 'database',
+    /// overriding the values already in there
+    void put(XrmDatabase &database) const;
 
 
     /// Add resource to list, only used in Resource<T>
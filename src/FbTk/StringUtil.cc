@@ -81,11 +81,11 @@ int extractBigNumber(const char* in, T (*extractFunc)(const char*, char**, int),
 }
 
 template<typename T>
-int extractSignedNumber(const std::string& in, T& out) {
+int extractSignedNumber(const char* in, T& out) {
 
     long long int result = 0;
 
-    if (::extractBigNumber(in.c_str(), strtoll, result)) {
+    if (::extractBigNumber(in, strtoll, result)) {
         out = static_cast<T>(result);
         return 1;
     }
@@ -94,11 +94,11 @@ int extractSignedNumber(const std::string& in, T& out) {
 }
 
 template<typename T>
-int extractUnsignedNumber(const std::string& in, T& out) {
+int extractUnsignedNumber(const char* in, T& out) {
 
     unsigned long long int result = 0;
 
-    if (::extractBigNumber(in.c_str(), strtoull, result) && result >= 0) {
+    if (::extractBigNumber(in, strtoull, result) && result >= 0) {
         out = static_cast<T>(result);
         return 1;
     }
@@ -115,36 +115,111 @@ namespace FbTk {
 
 namespace StringUtil {
 
-int extractNumber(const std::string& in, int& out) {
+int extractNumber(const char* in, int& out) {
     return ::extractSignedNumber<int>(in, out);
 }
 
-int extractNumber(const std::string& in, unsigned int& out) {
+int extractNumber(const char* in, unsigned int& out) {
     return ::extractUnsignedNumber<unsigned int>(in, out);
 }
 
-int extractNumber(const std::string& in, long& out) {
+int extractNumber(const char* in, long& out) {
     return ::extractSignedNumber<long>(in, out);
 }
 
-int extractNumber(const std::string& in, unsigned long& out) {
+int extractNumber(const char* in, unsigned long& out) {
     return ::extractUnsignedNumber<unsigned long>(in, out);
 }
 
-int extractNumber(const std::string& in, long long& out) {
+int extractNumber(const char* in, long long& out) {
     return ::extractSignedNumber<long long>(in, out);
 }
 
-int extractNumber(const std::string& in, unsigned long long& out) {
+int extractNumber(const char* in, unsigned long long& out) {
     return ::extractUnsignedNumber<unsigned long long>(in, out);
 }
 
+int extractNumber(const std::string& in, int& out) {
+    return extractNumber(in.c_str(), out);
+}
+
+int extractNumber(const std::string& in, unsigned int& out) {
+    return extractNumber(in.c_str(), out);
+}
+
+int extractNumber(const std::string& in, long& out) {
+    return extractNumber(in.c_str(), out);
+}
 
+int extractNumber(const std::string& in, unsigned long& out) {
+    return extractNumber(in.c_str(), out);
+}
+
+int extractNumber(const std::string& in, long long& out) {
+    return extractNumber(in.c_str(), out);
+}
+
+int extractNumber(const std::string& in, unsigned long long& out) {
+    return extractNumber(in.c_str(), out);
+}
+
+
+char *number2Chars(char *first, char *last, long long num) {
+    // work on the magnitude as unsigned, -LLONG_MIN does not fit
+    unsigned long long n = num;
+    if (num < 0)
+        n = 0 - n;
+
+    char digits[NUMBER_CHARS];
+    char *d = digits + sizeof(digits);
+    do {
+        *--d = '0' + n % 10;
+        n /= 10;
+    } while (n != 0);
+
+    size_t len = digits + sizeof(digits) - d + (num < 0 ? 1 : 0);
+    if (static_cast<size_t>(last - first) < len)
+        return 0;
+
+    if (num < 0)
+        *first++ = '-';
+    while (d != digits + sizeof(digits))
+        *first++ = *d++;
+    return first;
+}
+
+const char *chars2Number(const char *first, const char *last, long long &out) {
+    bool negative = first != last && *first == '-';
+    if (negative)
+        ++first;
+
+    if (first == last || *first < '0' || *first > '9' ||
+        (*first == '0' && (negative || (first + 1 != last &&
+                                        first[1] >= '0' && first[1] <= '9'))))
+        return 0;
+
+    // the magnitude may go one past LLONG_MAX for negative numbers
+    const unsigned long long max = (~0ULL >> 1) + (negative ? 1 : 0);
+    unsigned long long n = 0;
+    for (; first != last && *first >= '0' && *first <= '9'; ++first) {
+        unsigned int digit = *first - '0';
+        if (n > (max - digit) / 10)
+            return 0;
+        n = n * 10 + digit;
+    }
+
+    out = negative ? static_cast<long long>(0 - n) : static_cast<long long>(n);
+    return first;
+}
 
 std::string number2String(long long num) {
-    char s[128];
-    sprintf(s, "%lld", num);
-    return std::string(s);
+    char s[NUMBER_CHARS];
+    return std::string(s, number2Chars(s, s + sizeof(s), num));
+}
+
+void appendNumber(std::string &out, long long num) {
+    char s[NUMBER_CHARS];
+    out.append(s, number2Chars(s, s + sizeof(s), num));
 }
 
 /**
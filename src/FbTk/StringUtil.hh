@@ -39,12 +39,33 @@ int extractNumber(const std::string& in, int& out);
 int extractNumber(const std::string& in, unsigned long& out);
 int extractNumber(const std::string& in, long& out);
 int extractNumber(const std::string& in, long long& out);
-int extractNumber(const std::string& in, unsigned long& out);
+int extractNumber(const std::string& in, unsigned long long& out);
+int extractNumber(const char* in, unsigned int& out);
+int extractNumber(const char* in, int& out);
+int extractNumber(const char* in, unsigned long& out);
+int extractNumber(const char* in, long& out);
+int extractNumber(const char* in, long long& out);
+int extractNumber(const char* in, unsigned long long& out);
 /// \@}
 
+/// room for the longest number2Chars() result plus a terminating 0
+enum { NUMBER_CHARS = 24 };
+
+/// writes num in decimal to [first, last), without terminating 0
+/// @return end of the written number, 0 if it does not fit
+char *number2Chars(char *first, char *last, long long num);
+
+/// parses [first, last) the way number2Chars writes numbers: an
+/// optional '-' followed by digits, without leading zeros
+/// @return end of the number, 0 if there is none or it overflows
+const char *chars2Number(const char *first, const char *last, long long &out);
+
 /// creates a number to a string
 std::string number2String(long long num);
 
+/// appends num to out, without a temporary string
+void appendNumber(std::string &out, long long num);
+
 /// Similar to `strstr' but this function ignores the case of both strings
 const char *strcasestr(const char *str, const char *ptn);
 
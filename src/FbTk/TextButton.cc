@@ -23,6 +23,9 @@
 #include "TextUtils.hh"
 #include "Font.hh"
 #include "GContext.hh"
+#include "FbPixmap.hh"
+
+#include <algorithm>
 
 namespace FbTk {
 
@@ -36,11 +39,18 @@ TextButton::TextButton(const FbTk::FbWindow &parent,
     m_orientation(FbTk::ROT0),
     m_bevel(1),
     m_left_padding(0),
-    m_right_padding(0) {
+    m_right_padding(0),
+    m_label_revision(0) {
 
+    m_labels[0].pixmap = m_labels[1].pixmap = None;
     setRenderer(*this);
 }
 
+TextButton::~TextButton() {
+    freeLabel(m_labels[0]);
+    freeLabel(m_labels[1]);
+}
+
 void TextButton::resize(unsigned int width, unsigned int height) {
     if (this->width() == width && height == this->height())
         return;
@@ -73,9 +83,11 @@ bool TextButton::setOrientation(FbTk::Orientation orient) {
          (orient == FbTk::ROT0 || orient == FbTk::ROT180))) {
         // flip width and height
         m_orientation = orient;
+        invalidateLabel();
         resize(height(), width());
     } else {
         m_orientation = orient;
+        invalidateLabel();
     }
 
     return true;
@@ -84,6 +96,7 @@ bool TextButton::setOrientation(FbTk::Orientation orient) {
 void TextButton::setText(const FbTk::BiDiString &text) {
     if (m_text.logical() != text.logical()) {
         m_text = text;
+        invalidateLabel();
         updateBackground(false);
         clear();
     }
@@ -99,10 +112,12 @@ void TextButton::setFont(FbTk::Font &font) {
 
 void TextButton::setTextPaddingLeft(unsigned int leftpadding) {
     m_left_padding = leftpadding;
+    invalidateLabel();
 }
 
 void TextButton::setTextPaddingRight(unsigned int rightpadding) {
     m_right_padding = rightpadding;
+    invalidateLabel();
 }
 
 void TextButton::setTextPadding(unsigned int padding) {
@@ -141,10 +156,13 @@ void TextButton::drawText(int x_offset, int y_offset, FbDrawable *drawable) {
     unsigned int texth = height();
     translateSize(m_orientation, textw, texth);
 
+    // plain dots, every font has a glyph for them
+    static const char ellipsis[] = "...";
     int align_x = FbTk::doAlignment(textw - x_offset - m_left_padding - m_right_padding,
                                     bevel(), justify(), font(),
                                     visual.data(), visual.size(),
-                                    textlen); // return new text len
+                                    textlen, // return new text len
+                                    ellipsis);
 
     // center text by default
     int center_pos = texth/2 + font().ascent()/2 - 1;
@@ -155,6 +173,11 @@ void TextButton::drawText(int x_offset, int y_offset, FbDrawable *drawable) {
     if (drawable == 0)
         drawable = this;
 
+    // the text was cut, the ellipsis goes right after what is left of it
+    int ellipsis_x = textx;
+    if (textlen > 0 && textlen < visual.size())
+        ellipsis_x += font().textWidth(visual.data(), textlen);
+
     // give it ROT0 style coords
     translateCoords(m_orientation, textx, texty, textw, texth);
 
@@ -163,6 +186,14 @@ void TextButton::drawText(int x_offset, int y_offset, FbDrawable *drawable) {
                     gc(), // graphic context
                     visual.c_str(), textlen, // string and string size
                     textx, texty, m_orientation); // position
+
+    if (textlen < visual.size()) {
+        int ellipsis_y = center_pos + y_offset;
+        translateCoords(m_orientation, ellipsis_x, ellipsis_y, textw, texth);
+        font().drawText(*drawable, screenNumber(), gc(),
+                        ellipsis, sizeof(ellipsis) - 1,
+                        ellipsis_x, ellipsis_y, m_orientation);
+    }
 }
 
 
@@ -181,6 +212,86 @@ bool TextButton::textExceeds(int x_offset) {
     return visual.size()>textlen;
 }
 
+bool TextButton::LabelKey::operator == (const LabelKey &other) const {
+    return background == other.background &&
+        color_set == other.color_set &&
+        (!color_set || color == other.color) &&
+        foreground == other.foreground &&
+        width == other.width && height == other.height &&
+        font == other.font && font_revision == other.font_revision &&
+        justify == other.justify && revision == other.revision;
+}
+
+/// @return false if a label drawn on this background can't be reused
+bool TextButton::labelKey(LabelKey &key) const {
+
+    key.background = lastBackgroundPixmap();
+    key.color_set = lastBackgroundColor(key.color);
+
+    // transparent labels depend on whatever is behind them
+    if (key.background == ParentRelative || alpha() != 255 ||
+        (key.background == None && !key.color_set) || gc() == 0)
+        return false;
+
+    // Xlib keeps the gc values, no round trip
+    XGCValues gc_val;
+    XGetGCValues(display(), gc(), GCForeground, &gc_val);
+    key.foreground = gc_val.foreground;
+
+    key.width = width();
+    key.height = height();
+    key.font = m_font;
+    key.font_revision = m_font->revision();
+    key.justify = m_justify;
+    key.revision = m_label_revision;
+    return true;
+}
+
+void TextButton::freeLabel(Label &label) {
+    if (label.pixmap != None) {
+        Font::releaseDrawable(label.pixmap);
+        XFreePixmap(display(), label.pixmap);
+        label.pixmap = None;
+    }
+}
+
+void TextButton::updateBackground(bool only_if_alpha) {
+
+    LabelKey key;
+    if (!labelKey(key) || width() == 0 || height() == 0) {
+        Button::updateBackground(only_if_alpha);
+        return;
+    }
+
+    if (only_if_alpha)
+        return; // we're not transparent
+
+    if (m_labels[0].pixmap == None || !(m_labels[0].key == key)) {
+        if (m_labels[1].pixmap != None && m_labels[1].key == key) {
+            std::swap(m_labels[0], m_labels[1]);
+        } else {
+            // same as FbWindow::updateBackground, but the result is kept
+            FbPixmap newpm(*this, width(), height(), depth());
+            GC gc = XCreateGC(display(), window(), 0, 0);
+            if (key.background == None) {
+                XSetForeground(display(), gc, key.color);
+                newpm.fillRectangle(gc, 0, 0, width(), height());
+            } else
+                newpm.copyArea(key.background, gc, 0, 0, 0, 0, width(), height());
+            XFreeGC(display(), gc);
+
+            renderForeground(*this, newpm);
+
+            freeLabel(m_labels[1]);
+            m_labels[1] = m_labels[0];
+            m_labels[0].key = key;
+            m_labels[0].pixmap = newpm.release();
+        }
+    }
+
+    XSetWindowBackgroundPixmap(display(), window(), m_labels[0].pixmap);
+}
+
 void TextButton::exposeEvent(XExposeEvent &event) {
     clearArea(event.x, event.y, event.width, event.height, false);
 }
@@ -34,6 +34,7 @@ class TextButton: public FbTk::Button, FbTk::FbWindowRenderer {
 public:
     TextButton(const FbTk::FbWindow &parent, 
                FbTk::Font &font, const FbTk::BiDiString &text);
+    ~TextButton();
 
     void setJustify(FbTk::Justify just);
     bool setOrientation(FbTk::Orientation orient);
@@ -56,6 +57,8 @@ public:
 
     void exposeEvent(XExposeEvent &event);
 
+    void updateBackground(bool only_if_alpha);
+
     void renderForeground(FbDrawable &drawable);
 
     FbTk::Justify justify() const { return m_justify; }
@@ -71,8 +74,33 @@ protected:
     virtual void drawText(int x_offset, int y_offset, FbDrawable *drawable_override);
     // return true if the text will be truncated
     bool textExceeds(int x_offset);
+    /// drops the cached labels, for subclasses that draw something else now
+    void invalidateLabel() { ++m_label_revision; }
 
 private:
+    /// what a rendered label depends on
+    struct LabelKey {
+        bool operator == (const LabelKey &other) const;
+
+        Pixmap background;
+        bool color_set;
+        unsigned long color;
+        unsigned long foreground;
+        unsigned int width, height;
+        const Font *font;
+        unsigned int font_revision;
+        FbTk::Justify justify;
+        unsigned long revision;
+    };
+    /// a background with the label drawn on it
+    struct Label {
+        LabelKey key;
+        Pixmap pixmap;
+    };
+
+    bool labelKey(LabelKey &key) const;
+    void freeLabel(Label &label);
+
     FbTk::Font *m_font;
     BiDiString m_text;
     FbTk::Justify m_justify;
@@ -82,6 +110,10 @@ private:
     unsigned int m_left_padding; ///< space between buttonborder and text
     unsigned int m_right_padding; ///< space between buttonborder and text
 
+    // the last two rendered labels, enough to flip between focus states
+    // without drawing the text again
+    Label m_labels[2];
+    unsigned long m_label_revision; ///< changes whenever the label does
 };
 
 } // end namespace FbTk
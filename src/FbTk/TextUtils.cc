@@ -25,12 +25,35 @@
 #include "Theme.hh"
 
 #include <strings.h>
+#ifdef HAVE_CSTRING
+  #include <cstring>
+#else
+  #include <string.h>
+#endif
+
+namespace {
+
+struct FontWidth {
+    explicit FontWidth(const FbTk::Font &font): m_font(font) { }
+    unsigned int operator()(const char *text, unsigned int len) const {
+        return m_font.partialTextWidth(text, len);
+    }
+    const FbTk::Font &m_font;
+};
+
+} // end anonymous namespace
 
 namespace FbTk {
 
+unsigned int fitText(const FbTk::Font &font, const char *text,
+                     unsigned int textlen, int max_width) {
+    return fitTextWidth(FontWidth(font), text, textlen, max_width);
+}
+
 int doAlignment(int max_width, int bevel, FbTk::Justify justify,
                 const FbTk::Font &font, const char * const text,
-                unsigned int textlen, unsigned int &newlen) {
+                unsigned int textlen, unsigned int &newlen,
+                const char *ellipsis) {
 
     if (text == 0 || textlen == 0)
         return 0;
@@ -39,11 +62,12 @@ int doAlignment(int max_width, int bevel, FbTk::Justify justify,
     unsigned int dlen = textlen;
     int dx = bevel;
     if (l > max_width) {
-        for (; dlen > 0; dlen--) {
-            l = font.textWidth(text, dlen) + bevel;
-            if (l<=max_width)
-                break;
-        }
+        int ellipsis_width = 0;
+        if (ellipsis != 0 && *ellipsis != 0)
+            ellipsis_width = font.textWidth(ellipsis, strlen(ellipsis));
+
+        dlen = fitText(font, text, textlen, max_width - bevel - ellipsis_width);
+        l = (dlen > 0 ? font.partialTextWidth(text, dlen) : 0) + ellipsis_width + bevel;
     }
 
     newlen = dlen;
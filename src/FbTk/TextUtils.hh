@@ -28,12 +28,64 @@ namespace FbTk {
 
 class Font;
 
+/**
+   @return length of the longest start of text not wider than max_width,
+   cut between whole utf-8 characters
+ */
+unsigned int fitText(const FbTk::Font &font, const char *text,
+                     unsigned int textlen, int max_width);
+
+/// @return len moved back to the start of the utf-8 character it is in
+inline unsigned int utf8CharStart(const char *text, unsigned int len) {
+    while (len > 0 && (text[len] & 0xC0) == 0x80)
+        --len;
+    return len;
+}
+
+/**
+   fitText() for any width(text, len) function object, which lets it
+   be used without a font
+ */
+template <typename Width>
+unsigned int fitTextWidth(const Width &width, const char *text,
+                          unsigned int textlen, int max_width) {
+
+    if (text == 0 || textlen == 0 || max_width <= 0)
+        return 0;
+
+    if (static_cast<int>(width(text, textlen)) <= max_width)
+        return textlen;
+
+    // the width grows with the length, so the longest prefix that fits
+    // is found by bisecting the lengths, only ever cutting the text
+    // between whole characters
+    unsigned int lo = 0, hi = textlen - 1;
+    while (lo < hi) {
+        unsigned int mid = utf8CharStart(text, lo + (hi - lo + 1) / 2);
+        if (mid <= lo) {
+            // no character starts in that half, try the next one instead
+            mid = lo + 1;
+            while (mid < hi && (text[mid] & 0xC0) == 0x80)
+                ++mid;
+        }
+        if (static_cast<int>(width(text, mid)) <= max_width)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    return utf8CharStart(text, lo);
+}
+
 /**
    Aligns the text after max width and bevel
+   If the text is too wide, newlen is set to the length that fits. With an
+   ellipsis, room is left to draw it after those newlen bytes.
  */
 int doAlignment(int max_width, int bevel, FbTk::Justify justify, 
                 const FbTk::Font &font, const char * const text, 
-                unsigned int textlen, unsigned int &newlen);
+                unsigned int textlen, unsigned int &newlen,
+                const char *ellipsis = 0);
 
 /**
    There are 3 interesting translations:
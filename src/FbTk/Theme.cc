@@ -38,10 +38,64 @@
 #include <iostream>
 #include <algorithm>
 
+#include <sys/stat.h>
+#include <sys/types.h>
+
 using std::cerr;
 using std::endl;
 using std::string;
 
+namespace {
+
+/// number of styles ThemeManager keeps the lookups for
+const size_t MAX_COMPILED_STYLES = 8;
+
+/// first line of a compiled style, change it when the format changes
+const char COMPILED_MAGIC[] = "fluxbox compiled style 1";
+
+/// FNV-1a, names the cache file of a style
+std::string hashName(const std::string &str) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < str.size(); ++i) {
+        hash ^= static_cast<unsigned char>(str[i]);
+        hash *= 1099511628211ULL;
+    }
+    char name[17];
+    sprintf(name, "%016llx", hash);
+    return name;
+}
+
+void writeStamp(std::string &out, const FbTk::FileUtil::FileStamp &stamp) {
+    FbTk::StringUtil::appendNumber(out, stamp.mtime);
+    out += ' ';
+    FbTk::StringUtil::appendNumber(out, stamp.mtime_nsec);
+    out += ' ';
+    FbTk::StringUtil::appendNumber(out, stamp.size);
+    out += '\n';
+}
+
+/// reads a line and the '\n' after it
+bool readLine(FILE *file, std::string &line) {
+    line.clear();
+    int c;
+    while ((c = getc(file)) != EOF && c != '\n')
+        line += static_cast<char>(c);
+    return c == '\n';
+}
+
+bool readStamp(FILE *file, FbTk::FileUtil::FileStamp &stamp) {
+    long long mtime, size;
+    long nsec;
+    if (fscanf(file, "%lld %ld %lld", &mtime, &nsec, &size) != 3 || getc(file) != '\n')
+        return false;
+    stamp.mtime = mtime;
+    stamp.mtime_nsec = nsec;
+    stamp.size = size;
+    return true;
+}
+
+} // end anonymous namespace
+
 namespace FbTk {
 
 struct LoadThemeHelper {
@@ -80,7 +134,11 @@ ThemeManager::ThemeManager():
     // max_screens: we initialize this later so we can set m_verbose
     // without having a display connection
     m_max_screens(-1),
+    m_database_loaded(false),
     m_verbose(false),
+    m_current(0),
+    m_loads(0),
+    m_cache_dir(""),
     m_themelocation("") {
 
 }
@@ -137,22 +195,73 @@ bool ThemeManager::load(const string &filename,
         prefix = location.substr(0, location.find_last_of('/'));
     }
 
-    if (!m_database.load(location.c_str()))
-        return false;
+    string overlay_location;
+    if (!overlay_filename.empty()) {
+        overlay_location = FbTk::StringUtil::expandFilename(overlay_filename);
+        if (!FileUtil::isRegularFile(overlay_location.c_str()))
+            overlay_location = "";
+    }
 
+    // seconds alone would miss a style written twice within one
+    FileUtil::FileStamp location_stamp = FileUtil::getFileStamp(location.c_str());
+    FileUtil::FileStamp overlay_stamp;
+    if (!overlay_location.empty())
+        overlay_stamp = FileUtil::getFileStamp(overlay_location.c_str());
+
+    // lookups made after the last load, e.g. by themes created since
+    if (m_current != 0)
+        writeCompiled(*m_current);
+
+    CompiledStyles::iterator style = m_styles.find(location + '\n' + overlay_location);
+    if (style == m_styles.end() ||
+        style->second.location_stamp != location_stamp ||
+        style->second.overlay_stamp != overlay_stamp) {
+
+        // (re)compile it, keeping the current style if that fails
+        CompiledStyle *previous = m_current;
+        CompiledStyle compiled;
+        compiled.location = location;
+        compiled.overlay = overlay_location;
+        compiled.location_stamp = location_stamp;
+        compiled.overlay_stamp = overlay_stamp;
+        compiled.dirty = false;
+
+        m_current = &compiled;
+        m_database_loaded = false;
+        m_database.close();
+        // a fresh cache file saves parsing the style at all
+        if (!readCompiled(compiled) && !parseStyle()) {
+            // parsed again once something is looked up
+            m_current = previous;
+            m_database_loaded = false;
+            m_database.close();
+            return false;
+        }
 
-    if (!overlay_filename.empty()) {
-        string overlay_location = FbTk::StringUtil::expandFilename(overlay_filename);
-        if (FileUtil::isRegularFile(overlay_location.c_str())) {
-            XrmDatabaseHelper overlay_db;
-            if (overlay_db.load(overlay_location.c_str())) {
-                // after a merge the src_db is destroyed
-                // so, make sure XrmDatabaseHelper::m_database == 0
-                XrmMergeDatabases(*overlay_db, &(*m_database));
-                *overlay_db = 0;
+        if (style == m_styles.end() && m_styles.size() >= MAX_COMPILED_STYLES) {
+            CompiledStyles::iterator oldest = m_styles.begin();
+            CompiledStyles::iterator it = m_styles.begin();
+            for (; it != m_styles.end(); ++it) {
+                if (it->second.last_use < oldest->second.last_use)
+                    oldest = it;
             }
+            m_styles.erase(oldest);
         }
+
+        // m_database, if parsed, stays the one of the new style
+        CompiledStyle::Values values;
+        values.swap(compiled.values);
+        CompiledStyle &stored = m_styles[location + '\n' + overlay_location];
+        stored = compiled;
+        stored.values.swap(values);
+        m_current = &stored;
+    } else if (m_current != &style->second) {
+        // the database is only parsed if something new gets looked up
+        m_current = &style->second;
+        m_database_loaded = false;
+        m_database.close();
     }
+    m_current->last_use = ++m_loads;
 
     // relies on the fact that load_rc clears search paths each time
     if (m_themelocation != "") {
@@ -178,6 +287,8 @@ bool ThemeManager::load(const string &filename,
         load_theme_helper(m_themes[screen_num]);
     }
 
+    writeCompiled(*m_current);
+
     return true;
 }
 
@@ -206,11 +317,9 @@ bool ThemeManager::loadItem(ThemeItem_base &resource) {
 
 /// handles resource item loading with specific name/altname
 bool ThemeManager::loadItem(ThemeItem_base &resource, const string &name, const string &alt_name) {
-    XrmValue value;
-    char *value_type;
-    if (XrmGetResource(*m_database, name.c_str(),
-                       alt_name.c_str(), &value_type, &value)) {
-        resource.setFromString(value.addr);
+    string value;
+    if (lookup(name, alt_name, value)) {
+        resource.setFromString(value.c_str());
         resource.load(&name, &alt_name); // load additional stuff by the ThemeItem
     } else
         return false;
@@ -219,13 +328,148 @@ bool ThemeManager::loadItem(ThemeItem_base &resource, const string &name, const
 }
 
 string ThemeManager::resourceValue(const string &name, const string &altname) {
-    XrmValue value;
+    string value;
+    lookup(name, altname, value);
+    return value;
+}
+
+bool ThemeManager::lookup(const string &name, const string &altname,
+                          string &value) {
+    if (m_current == 0)
+        return false;
+
+    string key = name + '\n' + altname;
+    CompiledStyle::Values::iterator it = m_current->values.find(key);
+    if (it != m_current->values.end()) {
+        value = it->second.value;
+        return it->second.found;
+    }
+
+    // not asked for before, e.g. a theme created after the style was loaded
+    CompiledStyle::Value &result = m_current->values[key];
+    m_current->dirty = true;
+    XrmValue xrm_value;
     char *value_type;
-    if (*m_database != 0 && XrmGetResource(*m_database, name.c_str(),
-                                           altname.c_str(), &value_type, &value) && value.addr != 0)
-        return string(value.addr);
+    result.found = parseStyle() &&
+        XrmGetResource(*m_database, name.c_str(), altname.c_str(),
+                       &value_type, &xrm_value) && xrm_value.addr != 0;
+    if (result.found)
+        result.value = xrm_value.addr;
+
+    value = result.value;
+    return result.found;
+}
+
+bool ThemeManager::parseStyle() {
+    if (m_database_loaded)
+        return *m_database != 0;
+
+    m_database_loaded = true;
+    m_database.close();
+    if (m_current == 0 || !m_database.load(m_current->location.c_str()))
+        return false;
+
+    if (!m_current->overlay.empty()) {
+        XrmDatabaseHelper overlay_db;
+        if (overlay_db.load(m_current->overlay.c_str())) {
+            // after a merge the src_db is destroyed
+            // so, make sure XrmDatabaseHelper::m_database == 0
+            XrmMergeDatabases(*overlay_db, &(*m_database));
+            *overlay_db = 0;
+        }
+    }
+
+    return true;
+}
+
+string ThemeManager::cacheFilename(const CompiledStyle &style) const {
+    if (m_cache_dir.empty())
+        return "";
+    return m_cache_dir + "/" + hashName(style.location + '\n' + style.overlay);
+}
+
+bool ThemeManager::readCompiled(CompiledStyle &style) const {
+    string filename = cacheFilename(style);
+    if (filename.empty())
+        return false;
+
+    FILE *file = fopen(filename.c_str(), "r");
+    if (file == 0)
+        return false;
+
+    string line;
+    FileUtil::FileStamp location_stamp, overlay_stamp;
+    bool ok = readLine(file, line) && line == COMPILED_MAGIC &&
+        readLine(file, line) && line == style.location &&
+        readLine(file, line) && line == style.overlay &&
+        readStamp(file, location_stamp) && location_stamp == style.location_stamp &&
+        readStamp(file, overlay_stamp) && overlay_stamp == style.overlay_stamp;
+
+    // the lengths must fit in the rest of the file, a damaged
+    // file could ask for any amount of memory
+    struct stat file_stat;
+    unsigned long file_size = 0;
+    if (ok && fstat(fileno(file), &file_stat) == 0)
+        file_size = file_stat.st_size;
+
+    // then "found keylen valuelen\n", the key and the value for each lookup
+    CompiledStyle::Values values;
+    int found;
+    unsigned long keylen, valuelen;
+    while (ok && fscanf(file, "%d %lu %lu", &found, &keylen, &valuelen) == 3) {
+        long pos = ftell(file);
+        unsigned long left = (pos >= 0 && static_cast<unsigned long>(pos) < file_size) ?
+            file_size - pos - 1 : 0; // -1 for the '\n'
+        if (getc(file) != '\n' || keylen > left || valuelen > left - keylen) {
+            ok = false;
+            break;
+        }
+        string key(keylen, '\0');
+        CompiledStyle::Value value;
+        value.found = found != 0;
+        value.value.resize(valuelen);
+        ok = (keylen == 0 || fread(&key[0], keylen, 1, file) == 1) &&
+            (valuelen == 0 || fread(&value.value[0], valuelen, 1, file) == 1);
+        if (ok)
+            values[key] = value;
+    }
+    ok = ok && feof(file);
+    fclose(file);
+
+    if (ok)
+        style.values.swap(values);
+    return ok;
+}
+
+void ThemeManager::writeCompiled(CompiledStyle &style) const {
+    string filename = cacheFilename(style);
+    if (!style.dirty || filename.empty())
+        return;
+    style.dirty = false;
+
+    if (!FileUtil::isDirectory(m_cache_dir.c_str()) &&
+        mkdir(m_cache_dir.c_str(), 0700) != 0)
+        return;
+
+    string out = COMPILED_MAGIC;
+    out += '\n';
+    out += style.location + '\n' + style.overlay + '\n';
+    writeStamp(out, style.location_stamp);
+    writeStamp(out, style.overlay_stamp);
+
+    CompiledStyle::Values::const_iterator it = style.values.begin();
+    for (; it != style.values.end(); ++it) {
+        out += it->second.found ? '1' : '0';
+        out += ' ';
+        StringUtil::appendNumber(out, it->first.size());
+        out += ' ';
+        StringUtil::appendNumber(out, it->second.value.size());
+        out += '\n';
+        out += it->first;
+        out += it->second.value;
+    }
 
-    return "";
+    FileUtil::writeFile(filename.c_str(), out);
 }
 
 /*
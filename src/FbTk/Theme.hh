@@ -28,10 +28,12 @@
 
 #include "Signal.hh"
 #include "XrmDatabaseHelper.hh"
+#include "FileUtil.hh"
 
 #include <string>
 #include <list>
 #include <vector>
+#include <map>
 
 namespace FbTk {
 
@@ -150,6 +152,9 @@ public:
     bool verbose() const { return m_verbose; }
     void setVerbose(bool value) { m_verbose = value; }
 
+    /// keeps compiled styles in dir, so they survive a restart
+    void setCacheDirectory(const std::string &dir) { m_cache_dir = dir; }
+
     // dump theme out to filename, stdout if no filename is given
     void dump(Theme& theme, const char* filename = 0) const;
     //    void listItems();
@@ -165,11 +170,49 @@ private:
     bool unregisterTheme(FbTk::Theme &tm);
     /// map each theme manager to a screen
 
+    /// Every lookup made while loading a style, by name and altname.
+    /// Loading the unchanged style again answers them from here and
+    /// doesn't have to parse the files at all.
+    struct CompiledStyle {
+        struct Value {
+            bool found;
+            std::string value;
+        };
+        typedef std::map<std::string, Value> Values;
+
+        std::string location, overlay;
+        FileUtil::FileStamp location_stamp, overlay_stamp;
+        unsigned long last_use;
+        bool dirty; ///< has values that aren't in the cache file yet
+        Values values;
+    };
+    typedef std::map<std::string, CompiledStyle> CompiledStyles;
+
+    /// finds name/altname in the current style
+    /// @return true if the resource exists
+    bool lookup(const std::string &name, const std::string &altname,
+                std::string &value);
+    /// parses the current style into m_database, unless it already is
+    bool parseStyle();
+
+    /// @return name of the cache file for the style, "" if there is none
+    std::string cacheFilename(const CompiledStyle &style) const;
+    /// fills style from its cache file if that is still up to date
+    bool readCompiled(CompiledStyle &style) const;
+    /// writes style to its cache file if it has new values
+    void writeCompiled(CompiledStyle &style) const;
+
     ScreenThemeVector m_themes;
     int m_max_screens;
     XrmDatabaseHelper m_database;
+    bool m_database_loaded; ///< m_database holds m_current
     bool m_verbose;
 
+    CompiledStyles m_styles;
+    CompiledStyle *m_current; ///< style being loaded, or 0
+    unsigned long m_loads; ///< for evicting the least recently used style
+    std::string m_cache_dir;
+
     std::string m_themelocation;
 };
 
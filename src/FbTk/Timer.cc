@@ -54,6 +54,7 @@
 namespace FbTk {
 
 Timer::TimerList Timer::m_timerlist;
+Timer::InputMap Timer::m_inputs;
 
 Timer::Timer():m_timing(false), m_once(false), m_interval(0) {
 
@@ -132,6 +133,14 @@ void Timer::updateTimers(int fd) {
     FD_ZERO(&rfds);
     FD_SET(fd, &rfds);
 
+    int max_fd = fd;
+    InputMap::const_iterator input = m_inputs.begin();
+    for (; input != m_inputs.end(); ++input) {
+        FD_SET(input->first, &rfds);
+        if (input->first > max_fd)
+            max_fd = input->first;
+    }
+
     bool overdue = false;
 
     // see, if the first timer in the
@@ -169,9 +178,15 @@ void Timer::updateTimers(int fd) {
     // if not overdue, wait for the next xevent via the blocking
     // select(), so OS sends fluxbox to sleep. the select() will
     // time out when the next timer has to be handled
-    if (!overdue && select(fd + 1, &rfds, 0, 0, timeout) != 0)
-        // didn't time out! x events are pending
-        return;
+    if (!overdue) {
+        int ready = select(max_fd + 1, &rfds, 0, 0, timeout);
+        if (ready != 0) {
+            // didn't time out! x events or other input are pending
+            if (ready > 0)
+                handleInputs(rfds);
+            return;
+        }
+    }
 
     TimerList::iterator it;
 
@@ -224,6 +239,30 @@ void Timer::updateTimers(int fd) {
 
 }
 
+void Timer::handleInputs(const fd_set &rfds) {
+    // a handler might remove its own input, so collect them first
+    std::list<RefCount<Slot<void> > > ready;
+    InputMap::const_iterator it = m_inputs.begin();
+    for (; it != m_inputs.end(); ++it) {
+        if (FD_ISSET(it->first, &rfds))
+            ready.push_back(it->second);
+    }
+
+    while (!ready.empty()) {
+        (*ready.front())();
+        ready.pop_front();
+    }
+}
+
+void Timer::addInput(int fd, const RefCount<Slot<void> > &handler) {
+    if (fd >= 0 && fd < FD_SETSIZE && handler)
+        m_inputs[fd] = handler;
+}
+
+void Timer::removeInput(int fd) {
+    m_inputs.erase(fd);
+}
+
 void Timer::addTimer(Timer *timer) {
     assert(timer);
     int interval = timer->getInterval();
@@ -34,6 +34,7 @@
   #include <time.h>
 #endif
 #include <list>
+#include <map>
 #include <string>
 
 #ifdef HAVE_CONFIG_H
@@ -46,6 +47,7 @@
 
 #include <sys/types.h>
 #include <sys/time.h>
+#include <sys/select.h>
 #include <unistd.h>
 
 namespace FbTk {
@@ -76,6 +78,12 @@ public:
     void stop();
     /// update all timers
     static void updateTimers(int file_descriptor);
+    /**
+     * Watch an additional file descriptor while waiting for the next timer.
+     * The handler is called from updateTimers whenever fd becomes readable.
+     */
+    static void addInput(int fd, const RefCount<Slot<void> > &handler);
+    static void removeInput(int fd);
 
     int isTiming() const { return m_timing; }
     int getInterval() const { return m_interval; }
@@ -95,10 +103,15 @@ private:
     static void addTimer(Timer *timer);
     /// remove a timer from the static list
     static void removeTimer(Timer *timer);
+    /// call the handlers of the ready inputs
+    static void handleInputs(const fd_set &rfds);
 
     typedef std::list<Timer *> TimerList;
     static TimerList m_timerlist; ///< list of all timers, sorted by next trigger time (start + timeout)
 
+    typedef std::map<int, RefCount<Slot<void> > > InputMap;
+    static InputMap m_inputs; ///< extra file descriptors to watch in updateTimers
+
     RefCount<Slot<void> > m_handler; ///< what to do on a timeout
 
     bool m_timing; ///< clock running?
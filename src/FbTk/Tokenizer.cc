@@ -0,0 +1,224 @@
+// Tokenizer.cc for FbTk - Fluxbox Toolkit
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "Tokenizer.hh"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef HAVE_CSTRING
+  #include <cstring>
+#else
+  #include <string.h>
+#endif
+
+namespace {
+
+const char s_empty[] = "";
+
+inline bool isOneOf(char c, const char *chars) {
+    return c != '\0' && strchr(chars, c) != 0;
+}
+
+} // end anonymous namespace
+
+namespace FbTk {
+
+bool Token::operator == (const char *str) const {
+    size_t len = strlen(str);
+    return len == size() && memcmp(m_begin, str, len) == 0;
+}
+
+bool Token::iequals(const char *str) const {
+    size_t len = strlen(str);
+    return len == size() && strncasecmp(m_begin, str, len) == 0;
+}
+
+Token Token::trimmed() const {
+    const char *begin = m_begin, *end = m_end;
+    while (begin != end && (*begin == ' ' || *begin == '\t'))
+        ++begin;
+    while (end != begin && (end[-1] == ' ' || end[-1] == '\t'))
+        --end;
+    return Token(begin, end, m_escaped);
+}
+
+std::string Token::str() const {
+    std::string out;
+    assignTo(out);
+    return out;
+}
+
+void Token::assignTo(std::string &out) const {
+    if (!m_escaped) {
+        out.assign(m_begin, m_end);
+        return;
+    }
+
+    out.clear();
+    for (const char *c = m_begin; c != m_end; ++c) {
+        if (*c == '\\' && c + 1 != m_end && c[1] == m_escaped)
+            continue;
+        out += *c;
+    }
+}
+
+Tokenizer::Tokenizer():
+    m_data(0), m_data_end(0),
+    m_line(0), m_line_end(0), m_pos(0), m_next(0),
+    m_row(0), m_eof(true),
+    m_map(0), m_map_size(0) {
+}
+
+Tokenizer::Tokenizer(const char *data, size_t size):
+    m_map(0), m_map_size(0) {
+    setData(data, size);
+}
+
+bool Tokenizer::open(const std::string &filename) {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    bool regular = fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+    if (regular && st.st_size == 0) {
+        ::close(fd);
+        setData(s_empty, 0);
+        return true;
+    }
+
+    if (regular) {
+        void *map = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            m_map = map;
+            m_map_size = st.st_size;
+        }
+    }
+
+    if (m_map == 0) {
+        // no luck, read it the old way
+        char buffer[4096];
+        ssize_t len;
+        while ((len = read(fd, buffer, sizeof(buffer))) > 0)
+            m_buffer.insert(m_buffer.end(), buffer, buffer + len);
+    }
+    ::close(fd);
+
+    if (m_map)
+        setData(static_cast<const char *>(m_map), m_map_size);
+    else if (m_buffer.empty())
+        setData(s_empty, 0);
+    else
+        setData(&m_buffer[0], m_buffer.size());
+    return true;
+}
+
+void Tokenizer::close() {
+    if (m_map)
+        munmap(m_map, m_map_size);
+    m_map = 0;
+    m_map_size = 0;
+    std::vector<char>().swap(m_buffer);
+
+    m_data = m_data_end = 0;
+    m_line = m_line_end = m_pos = m_next = 0;
+    m_row = 0;
+    m_eof = true;
+}
+
+void Tokenizer::setData(const char *data, size_t size) {
+    m_data = data;
+    m_data_end = data + size;
+    m_line = m_line_end = m_pos = m_next = data;
+    m_row = 0;
+    m_eof = false;
+}
+
+bool Tokenizer::nextLine() {
+    if (m_next == m_data_end) {
+        m_eof = true;
+        return false;
+    }
+
+    m_line = m_next;
+    const char *newline = static_cast<const char *>(
+        memchr(m_line, '\n', m_data_end - m_line));
+    m_line_end = newline ? newline : m_data_end;
+    m_next = newline ? newline + 1 : m_data_end;
+    m_pos = m_line;
+    ++m_row;
+    return true;
+}
+
+bool Tokenizer::word(Token &out, const char *delimiters) {
+    const char *pos = m_pos;
+    while (pos != m_line_end && isOneOf(*pos, delimiters))
+        ++pos;
+    if (pos == m_line_end) {
+        m_pos = pos;
+        return false;
+    }
+
+    const char *begin = pos;
+    while (pos != m_line_end && !isOneOf(*pos, delimiters))
+        ++pos;
+
+    out = Token(begin, pos);
+    m_pos = pos;
+    return true;
+}
+
+bool Tokenizer::between(char first, char last, Token &out,
+                        const char *ok_chars) {
+    const char *pos = m_pos;
+    while (pos != m_line_end && isOneOf(*pos, ok_chars))
+        ++pos;
+    if (pos == m_line_end || *pos != first)
+        return false;
+
+    const char *begin = ++pos;
+    char escaped = 0;
+    for (; pos != m_line_end; ++pos) {
+        if (*pos != last)
+            continue;
+        if (pos[-1] == '\\') {
+            escaped = last;
+            continue;
+        }
+        out = Token(begin, pos, escaped);
+        m_pos = pos + 1;
+        return true;
+    }
+    return false;
+}
+
+} // end namespace FbTk
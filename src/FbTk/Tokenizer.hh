@@ -0,0 +1,127 @@
+// Tokenizer.hh for FbTk - Fluxbox Toolkit
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef FBTK_TOKENIZER_HH
+#define FBTK_TOKENIZER_HH
+
+#include "NotCopyable.hh"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace FbTk {
+
+/**
+ * A piece of the buffer of a Tokenizer. It does not own any memory and
+ * is only valid as long as the buffer is; use str() to keep the value.
+ */
+class Token {
+public:
+    Token(): m_begin(0), m_end(0), m_escaped(0) { }
+    /// @param escaped a character which has '\' in front of it in the
+    ///        buffer and loses it in str()
+    Token(const char *begin, const char *end, char escaped = 0):
+        m_begin(begin), m_end(end), m_escaped(escaped) { }
+
+    const char *begin() const { return m_begin; }
+    const char *end() const { return m_end; }
+    size_t size() const { return m_end - m_begin; }
+    bool empty() const { return m_begin == m_end; }
+    char operator [] (size_t i) const { return m_begin[i]; }
+    char back() const { return m_end[-1]; }
+
+    bool operator == (const char *str) const;
+    bool operator != (const char *str) const { return !(*this == str); }
+    /// case insensitive compare
+    bool iequals(const char *str) const;
+
+    /// @return the token without leading and trailing spaces and tabs
+    Token trimmed() const;
+
+    std::string str() const;
+    /// like str(), but reuses the memory of out
+    void assignTo(std::string &out) const;
+
+private:
+    const char *m_begin, *m_end;
+    char m_escaped;
+};
+
+/**
+ * Splits a file or a buffer into lines and the lines into tokens without
+ * copying anything. Files are memory mapped while they are open.
+ */
+class Tokenizer: private NotCopyable {
+public:
+    Tokenizer();
+    /// tokenize a buffer owned by the caller
+    Tokenizer(const char *data, size_t size);
+    ~Tokenizer() { close(); }
+
+    bool open(const std::string &filename);
+    void close();
+    bool isOpen() const { return m_data != 0; }
+
+    /// go to the next line
+    /// @return false if there is no line left
+    bool nextLine();
+    /// @return true if nextLine failed
+    bool eof() const { return m_eof; }
+    /// @return number of the current line, starting at 1
+    int row() const { return m_row; }
+    /// start over with the tokens of the current line
+    void resetLine() { m_pos = m_line; }
+
+    /// @return the current line
+    Token line() const { return Token(m_line, m_line_end); }
+    /// @return the not yet tokenized part of the current line
+    Token rest() const { return Token(m_pos, m_line_end); }
+
+    /// next token of the line that is separated by one of delimiters
+    bool word(Token &out, const char *delimiters = " \t\n");
+
+    /**
+     * Reads a token enclosed by first and last, after any of the leading
+     * ok_chars, like StringUtil::getStringBetween does. An escaped last
+     * character does not end the token. Nothing is consumed on failure.
+     */
+    bool between(char first, char last, Token &out,
+                 const char *ok_chars = " \t\n");
+
+private:
+    void setData(const char *data, size_t size);
+
+    const char *m_data, *m_data_end;
+    const char *m_line, *m_line_end, *m_pos;
+    const char *m_next; ///< start of the next line
+    int m_row;
+    bool m_eof;
+
+    void *m_map;
+    size_t m_map_size;
+    std::vector<char> m_buffer; ///< for files that can't be mapped
+};
+
+} // end namespace FbTk
+
+#endif // FBTK_TOKENIZER_HH
@@ -23,62 +23,40 @@
 #define FBTK_TYPEAHEAD_HH
 
 #include "ITypeAheadable.hh"
-#include "SearchResult.hh"
+
+#include <vector>
+#include <string>
+#include <algorithm>
 
 namespace FbTk {
 
+/**
+ * Prefix search over the iTypeString()s of a vector of items.
+ *
+ * The lower-cased labels are kept sorted, so all items matching the
+ * search string are one range of that array. Every typed character
+ * narrows the range with two binary searches, and backspace pops the
+ * previous ranges from a small undo log. The index is rebuilt when a
+ * search starts and the items or their labels changed since.
+ */
 template <typename Items, typename Item_Type>
 class TypeAhead {
-#if 0
-
-// a class template can't be split into separate interface + implementation files, an interface summary is given here:
-
 public:
-    void init(Items const &items);
-
-// accessors:
-    int stringSize() const { return m_searchstr.size(); }
-    Items matched() const;
-
-// modifiers:
-    Items putCharacter(char ch);
-    void putBackSpace();
-    void reset()
-
-private:
-    SearchResults m_search_results;
-    std::string m_searchstr;
-    Items const *m_ref;
-
-// helper
-    void fillValues(BaseItems const &search, ValueVec &fillin) const;
 
-// reverts to searchstate before current
-    void revert();
-
-// search performs iteration and sets state
-    void search(char char_to_test);
-    void doSearch(char to_test,
-            Items const &items,
-            SearchResult &mySearchResult) const;
-    void doSearch(char to_test,
-            BaseItems const &search,
-            SearchResult &mySearchResult) const;
-#endif
-
-public:
-    typedef std::vector < ITypeAheadable* > BaseItems;
-    typedef BaseItems::const_iterator BaseItemscIt;
-    typedef std::vector < SearchResult > SearchResults;
-    typedef typename Items::const_iterator ItemscIt;
+    TypeAhead(): m_ref(0) { }
 
-    void init(Items const &items) { m_ref = &items; }
+    void init(Items const &items) {
+        m_ref = &items;
+        m_index.clear();
+        reset();
+    }
 
     size_t stringSize() const { return m_searchstr.size(); }
 
+    /// completes the search string as far as all matches agree
     void seek() {
-        if (!m_search_results.empty())
-            m_searchstr = m_search_results.back().seekedString();
+        if (!m_steps.empty())
+            m_searchstr = seekedString(m_steps.back());
     }
 
     Items putCharacter(char ch) {
@@ -88,83 +66,184 @@ public:
     }
 
     void putBackSpace() {
-        if (!m_search_results.empty())
+        if (!m_steps.empty())
             revert();
     }
 
     void reset() {
         m_searchstr.clear();
-        m_search_results.clear();
+        m_steps.clear();
     }
 
+    /// @return enabled items matching the search string, in their order
     Items matched() const {
-        Items last_matched;
-
-        if (!m_search_results.empty())
-            fillValues(m_search_results.back().result(), last_matched);
-        else
+        if (m_steps.empty())
             return *m_ref;
+
+        const Step &step = m_steps.back();
+        std::vector<size_t> positions;
+        positions.reserve(step.end - step.begin);
+        for (size_t i = step.begin; i < step.end; ++i) {
+            if (item(m_index[i].pos)->isEnabled())
+                positions.push_back(m_index[i].pos);
+        }
+        std::sort(positions.begin(), positions.end());
+
+        Items last_matched;
+        for (size_t i = 0; i < positions.size(); ++i)
+            last_matched.push_back((*m_ref)[positions[i]]);
         return last_matched;
     }
 
 private:
-    SearchResults m_search_results;
+
+    struct Entry {
+        std::string label; ///< lower-cased iTypeString()
+        size_t pos; ///< in *m_ref
+
+        bool operator < (const Entry &other) const {
+            return label < other.label;
+        }
+    };
+    typedef std::vector<Entry> Index;
+
+    /// the range of m_index matching the search string after a character
+    struct Step {
+        size_t begin, end;
+        bool narrowed; ///< less enabled items match than before
+    };
+    typedef std::vector<Step> Steps;
+
+    Index m_index;
+    Steps m_steps; ///< undo log, one step per narrowing character
     std::string m_searchstr;
     Items const *m_ref; // reference to vector we are operating on
 
-    void fillValues(BaseItems const &search, Items &fillin) const {
-        for (BaseItemscIt it = search.begin(); it != search.end(); it++) {
-            Item_Type tmp = dynamic_cast<Item_Type>(*it);
-            if (tmp)
-                fillin.push_back(tmp);
+    Item_Type item(size_t pos) const { return (*m_ref)[pos]; }
+
+    static char lower(char ch) { return tolower(ch); }
+
+    /// compares the start of entry i with 'prefix'
+    int comparePrefix(size_t i, const std::string &prefix) const {
+        return m_index[i].label.compare(0, prefix.size(), prefix);
+    }
+
+    bool indexIsCurrent() const {
+        if (m_index.size() != m_ref->size())
+            return false;
+        for (size_t i = 0; i < m_index.size(); ++i) {
+            const std::string &label = m_index[i].label;
+            const std::string &current = item(m_index[i].pos)->iTypeString();
+            if (label.size() != current.size())
+                return false;
+            for (size_t c = 0; c < label.size(); ++c) {
+                if (label[c] != lower(current[c]))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void buildIndex() {
+        m_index.resize(m_ref->size());
+        for (size_t i = 0; i < m_index.size(); ++i) {
+            const std::string &label = item(i)->iTypeString();
+            m_index[i].label.resize(label.size());
+            std::transform(label.begin(), label.end(),
+                           m_index[i].label.begin(), lower);
+            m_index[i].pos = i;
+        }
+        std::sort(m_index.begin(), m_index.end());
+    }
+
+    size_t countEnabled(size_t begin, size_t end) const {
+        size_t count = 0;
+        for (size_t i = begin; i < end; ++i) {
+            if (item(m_index[i].pos)->isEnabled())
+                ++count;
         }
+        return count;
     }
 
+    /// @return the common start of the enabled items in 'step', in the
+    /// case of the first of them
+    std::string seekedString(const Step &step) const {
+        size_t first = step.end, last = step.end;
+        size_t first_pos = m_ref->size();
+        for (size_t i = step.begin; i < step.end; ++i) {
+            if (!item(m_index[i].pos)->isEnabled())
+                continue;
+            if (first == step.end)
+                first = i;
+            last = i;
+            first_pos = std::min(first_pos, m_index[i].pos);
+        }
+        if (first == step.end)
+            return m_searchstr;
+
+        // sorted: what the first and last share, all in between share
+        const std::string &a = m_index[first].label;
+        const std::string &b = m_index[last].label;
+        size_t length = 0;
+        while (length < a.size() && length < b.size() && a[length] == b[length])
+            ++length;
+
+        return item(first_pos)->iTypeString().substr(0, length);
+    }
+
+    // undoes the characters back to and including the last one that
+    // narrowed the search
     void revert() {
-        m_search_results.pop_back();
-        if (m_search_results.empty())
+        while (!m_steps.empty() && !m_steps.back().narrowed)
+            m_steps.pop_back();
+        if (!m_steps.empty())
+            m_steps.pop_back();
+        if (m_steps.empty())
             m_searchstr.clear();
         else
-            m_searchstr = m_search_results.back().seekedString();
+            m_searchstr = seekedString(m_steps.back());
     }
 
     void search(char char_to_test) {
-        SearchResult mySearchResult(m_searchstr + char_to_test);
-        size_t num_items = m_ref->size();
-
-        // check if we have already a searched set
-        if (m_search_results.empty())
-            doSearch(char_to_test, *m_ref, mySearchResult);
-        else {
-            num_items = m_search_results.back().size();
-            doSearch(char_to_test, m_search_results.back().result(),
-                     mySearchResult);
-        }
+        if (m_steps.empty() && !indexIsCurrent())
+            buildIndex();
 
-        if (mySearchResult.size() > 0 ) {
-            if (mySearchResult.size() < num_items) {
-                mySearchResult.seek();
-                m_search_results.push_back(mySearchResult);
-            }
-            m_searchstr += char_to_test;
+        size_t begin = 0, end = m_index.size();
+        if (!m_steps.empty()) {
+            begin = m_steps.back().begin;
+            end = m_steps.back().end;
         }
-    }
-
-    // iteration based on original list of items
-    void doSearch(char to_test, Items const &items,
-                  SearchResult &mySearchResult) const {
-        for (ItemscIt it = items.begin(); it != items.end(); it++) {
-            if ((*it)->iTypeCompareChar(to_test, stringSize()) && (*it)->isEnabled())
-                mySearchResult.add(*it);
+        const size_t num_items = countEnabled(begin, end);
+
+        std::string prefix(m_searchstr + char_to_test);
+        std::transform(prefix.begin(), prefix.end(), prefix.begin(), lower);
+
+        // sorted, so truncating each label to the length of the prefix
+        // keeps the order: one binary search for each end of the range
+        size_t lo = begin, hi = end;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (comparePrefix(mid, prefix) < 0)
+                lo = mid + 1;
+            else
+                hi = mid;
         }
-    }
+        const size_t new_begin = lo;
+        hi = end;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (comparePrefix(mid, prefix) <= 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        const size_t new_end = lo;
 
-    // iteration based on last SearchResult
-    void doSearch(char to_test, BaseItems const &search,
-                  SearchResult &mySearchResult) const {
-        for (BaseItemscIt it = search.begin(); it != search.end(); it++) {
-            if ((*it)->iTypeCompareChar(to_test, stringSize()) && (*it)->isEnabled())
-                mySearchResult.add(*it);
+        size_t matches = countEnabled(new_begin, new_end);
+        if (matches > 0) {
+            Step step = { new_begin, new_end, matches < num_items };
+            m_steps.push_back(step);
+            m_searchstr += char_to_test;
         }
     }
 
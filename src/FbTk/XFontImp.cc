@@ -85,6 +85,7 @@ bool XFontImp::load(const string &fontname) {
         XFreeFont(App::instance()->display(), m_fontstruct);
 
     m_fontstruct = font; //set new font
+    clearWidthCache();
 
     for (int i = ROT0; i <= ROT270; ++i) {
         m_rotfonts_loaded[i] = false;
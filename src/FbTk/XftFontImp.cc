@@ -24,13 +24,116 @@
 #include "FbDrawable.hh"
 
 #include <math.h>
+#include <map>
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
 #endif //HAVE_CONFIG_H
 
+namespace {
+
+// One XftDraw per screen, pointed at whatever drawable is drawn to next.
+// Creating one per call costs an allocation, and a geometry round trip the
+// first time Xft needs the depth of the drawable.
+struct ScreenDraw {
+    XftDraw *draw;
+    Drawable drawable;
+};
+
+typedef std::map<int, ScreenDraw> Draws;
+Draws s_draws;
+
+XftDraw *drawFor(Display *disp, int screen, Drawable drawable) {
+    ScreenDraw &sd = s_draws[screen];
+    if (sd.draw == 0)
+        sd.draw = XftDrawCreate(disp, drawable, DefaultVisual(disp, screen),
+                                DefaultColormap(disp, screen));
+    else if (sd.drawable != drawable)
+        XftDrawChange(sd.draw, drawable);
+    sd.drawable = drawable;
+    return sd.draw;
+}
+
+// XftColors of the gc foregrounds we've drawn with, by pixel and visual.
+// Resolving a pixel to rgb values takes a XQueryColor round trip, so
+// that happens once per color instead of once per string.
+struct CachedColor {
+    XftColor color;
+    Colormap colormap;
+};
+
+typedef std::map<std::pair<unsigned long, Visual *>, CachedColor> Colors;
+Colors s_colors;
+
+// enough for the text colors of a few styles
+const size_t MAX_COLORS = 64;
+
+void freeColors(Display *disp) {
+    Colors::iterator it = s_colors.begin();
+    for (; it != s_colors.end(); ++it)
+        XftColorFree(disp, it->first.second, it->second.colormap,
+                     &it->second.color);
+    s_colors.clear();
+}
+
+const XftColor &colorFor(Display *disp, int screen, GC gc) {
+
+    // served from Xlib's copy of the gc, no round trip
+    XGCValues gc_val;
+    XGetGCValues(disp, gc, GCForeground, &gc_val);
+
+    Visual *visual = DefaultVisual(disp, screen);
+    Colors::key_type key(gc_val.foreground, visual);
+    Colors::iterator it = s_colors.find(key);
+    if (it != s_colors.end())
+        return it->second.color;
+
+    if (s_colors.size() >= MAX_COLORS)
+        freeColors(disp);
+
+    CachedColor &cached = s_colors[key];
+    cached.colormap = DefaultColormap(disp, screen);
+
+    XColor xcol;
+    xcol.pixel = gc_val.foreground;
+    XQueryColor(disp, cached.colormap, &xcol);
+
+    XRenderColor rendcol;
+    rendcol.red = xcol.red;
+    rendcol.green = xcol.green;
+    rendcol.blue = xcol.blue;
+    rendcol.alpha = 0xFFFF;
+    XftColorAllocValue(disp, visual, cached.colormap, &rendcol, &cached.color);
+
+    return cached.color;
+}
+
+} // end anonymous namespace
+
 namespace FbTk {
 
+void XftFontImp::releaseDrawable(Drawable drawable) {
+    Draws::iterator it = s_draws.begin();
+    while (it != s_draws.end()) {
+        // the drawable's xrender picture has to go before the drawable
+        if (it->second.drawable == drawable && it->second.draw != 0) {
+            XftDrawDestroy(it->second.draw);
+            s_draws.erase(it++);
+        } else
+            ++it;
+    }
+}
+
+void XftFontImp::shutdown() {
+    Draws::iterator it = s_draws.begin();
+    for (; it != s_draws.end(); ++it) {
+        if (it->second.draw != 0)
+            XftDrawDestroy(it->second.draw);
+    }
+    s_draws.clear();
+    freeColors(App::instance()->display());
+}
+
 XftFontImp::XftFontImp(const char *name, bool utf8):
     m_utf8mode(utf8), m_name("") {
 
@@ -73,6 +176,7 @@ bool XftFontImp::load(const std::string &name) {
     m_xftfonts[ROT0] = newxftfont;
     m_xftfonts_loaded[ROT0] = true;
     m_name = name;
+    clearWidthCache();
 
     return true;
 }
@@ -101,53 +205,24 @@ void XftFontImp::drawText(const FbDrawable &w, int screen, GC gc, const char* te
         break;
     }
 
-    Visual* def_visual = DefaultVisual(w.display(), screen);
-    Colormap def_colmap = DefaultColormap(w.display(), screen);
-
     XftFont *font = m_xftfonts[orient];
-    XftDraw *draw = XftDrawCreate(w.display(), w.drawable(), def_visual, def_colmap);
-
-    XGCValues gc_val;
-
-    // get foreground pixel value and convert it to XRenderColor value
-    // TODO: we should probably check return status
-    XGetGCValues(w.display(), gc, GCForeground, &gc_val);
-
-    // get red, green, blue values
-    XColor xcol;
-    xcol.pixel = gc_val.foreground;
-    XQueryColor(w.display(), def_colmap, &xcol);
-
-    // convert xcolor to XftColor
-    XRenderColor rendcol;
-    rendcol.red = xcol.red;
-    rendcol.green = xcol.green;
-    rendcol.blue = xcol.blue;
-    rendcol.alpha = 0xFFFF;
-    XftColor xftcolor;
-    XftColorAllocValue(w.display(), def_visual, def_colmap, &rendcol, &xftcolor);
+    XftDraw *draw = drawFor(w.display(), screen, w.drawable());
+    const XftColor &xftcolor = colorFor(w.display(), screen, gc);
 
     // draw string
 #ifdef HAVE_XFT_UTF8_STRING
     if (m_utf8mode) {
-        // check the string size,
-        // if the size is zero we use the XftDrawString8 function instead.
-        XGlyphInfo ginfo;
-        XftTextExtentsUtf8(w.display(), m_xftfonts[ROT0], (XftChar8 *)text, len, &ginfo);
-        if (ginfo.xOff != 0) {
+        // if the string isn't valid utf-8 we use the XftDrawString8
+        // function instead
+        int chars, char_width;
+        if (FcUtf8Len((FcChar8 *)text, len, &chars, &char_width)) {
             XftDrawStringUtf8(draw, &xftcolor, font, x, y, (XftChar8 *)text, len);
-            XftColorFree(w.display(), def_visual, def_colmap, &xftcolor);
-            XftDrawDestroy(draw);
             return;
         }
     }
 #endif // HAVE_XFT_UTF8_STRING
 
     XftDrawString8(draw, &xftcolor, font, x, y, (XftChar8 *)text, len);
-
-
-    XftColorFree(w.display(), def_visual, def_colmap, &xftcolor);
-    XftDrawDestroy(draw);
 }
 
 unsigned int XftFontImp::textWidth(const char* text, unsigned int len) const {
@@ -216,14 +291,19 @@ bool XftFontImp::validOrientation(FbTk::Orientation orient) {
 
     Display *disp = App::instance()->display();
 
-    XftPattern * pattern = XftNameParse(m_name.c_str());
-    XftResult result;
-    pattern = XftFontMatch(disp, 0, pattern, &result);
+    // start from the pattern the upright font was matched with, m_name
+    // may be a XLFD name that XftNameParse can't read
+    XftPattern *pattern = FcPatternDuplicate(m_xftfonts[ROT0]->pattern);
+    if (pattern == 0)
+        return false;
+    FcPatternDel(pattern, XFT_MATRIX);
     XftPatternAddMatrix(pattern, XFT_MATRIX, &matrix);
     XftFont * new_font = XftFontOpenPattern(disp, pattern);
 
-    if (new_font == 0)
+    if (new_font == 0) {
+        FcPatternDestroy(pattern);
         return false;
+    }
 
     m_xftfonts[orient] = new_font;
 
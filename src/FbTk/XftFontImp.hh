@@ -31,6 +31,11 @@ namespace FbTk {
 /// Handles Xft font drawing
 class XftFontImp:public FbTk::FontImp {
 public:
+    /// drops the cached XftDraw of a drawable that is about to be destroyed
+    static void releaseDrawable(Drawable drawable);
+    /// frees the cached XftDraws and XftColors
+    static void shutdown();
+
     XftFontImp(const char *fontname, bool utf8);
     ~XftFontImp();
     bool load(const std::string &name);
@@ -185,6 +185,7 @@ bool XmbFontImp::load(const string &fontname) {
 
     m_fontset = set;
     m_setextents = XExtentsOfFontSet(m_fontset);
+    clearWidthCache();
 
     return true;
 }
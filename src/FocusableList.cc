@@ -42,6 +42,38 @@
 using std::string;
 using std::vector;
 
+namespace {
+
+unsigned int prop(ClientPattern::WinProperty p) { return 1 << p; }
+
+// nothing tells us when these change, so they are checked along with
+// everything else
+const unsigned int UNTRACKED_PROPS =
+    prop(ClientPattern::HEAD) | prop(ClientPattern::TRANSIENT) |
+    prop(ClientPattern::XPROP);
+
+const unsigned int WORKSPACE_PROPS = UNTRACKED_PROPS |
+    prop(ClientPattern::WORKSPACE) | prop(ClientPattern::WORKSPACENAME);
+
+const unsigned int STATE_PROPS = UNTRACKED_PROPS |
+    prop(ClientPattern::MAXIMIZED) | prop(ClientPattern::MINIMIZED) |
+    prop(ClientPattern::SHADED) | prop(ClientPattern::STUCK) |
+    prop(ClientPattern::FOCUSHIDDEN) | prop(ClientPattern::ICONHIDDEN) |
+    prop(ClientPattern::URGENT) | prop(ClientPattern::LAYER);
+
+const unsigned int LAYER_PROPS = UNTRACKED_PROPS | prop(ClientPattern::LAYER);
+
+const unsigned int CLIENT_TITLE_PROPS = UNTRACKED_PROPS |
+    prop(ClientPattern::TITLE);
+
+// the title signal of a FluxboxWindow also fires when its current client
+// changes, which changes everything the window reports about its client
+const unsigned int WINDOW_TITLE_PROPS = CLIENT_TITLE_PROPS |
+    prop(ClientPattern::CLASS) | prop(ClientPattern::NAME) |
+    prop(ClientPattern::ROLE) | prop(ClientPattern::URGENT);
+
+} // end anonymous namespace
+
 void FocusableList::parseArgs(const string &in, int &opts, string &pat) {
     string options;
     int err = FbTk::StringUtil::getStringBetween(options, in.c_str(), '{', '}',
@@ -111,18 +143,30 @@ void FocusableList::init() {
     }
 }
 
-void FocusableList::windowUpdated(FluxboxWindow &fbwin) {
-    if (m_screen.isShuttingdown())
+void FocusableList::windowWorkspaceChanged(FluxboxWindow &fbwin) {
+    windowUpdated(fbwin, WORKSPACE_PROPS);
+}
+
+void FocusableList::windowStateChanged(FluxboxWindow &fbwin) {
+    windowUpdated(fbwin, STATE_PROPS);
+}
+
+void FocusableList::windowLayerChanged(FluxboxWindow &fbwin) {
+    windowUpdated(fbwin, LAYER_PROPS);
+}
+
+void FocusableList::windowUpdated(FluxboxWindow &fbwin, unsigned int changed_props) {
+    if (m_screen.isShuttingdown() || !(m_pat->dependencies() & changed_props))
         return;
 
     // we only bind these for matching patterns, so skip finding out signal
     if (m_parent->contains(fbwin))
-        checkUpdate(fbwin);
+        checkUpdate(fbwin, changed_props);
     const std::list<WinClient *> &list = fbwin.clientList();
     std::list<WinClient *>::const_iterator it = list.begin(), it_end = list.end();
     for (; it != it_end; ++it) {
         if (m_parent->contains(**it))
-            checkUpdate(**it);
+            checkUpdate(**it, changed_props);
     }
 }
 
@@ -148,10 +192,14 @@ void FocusableList::parentWindowRemoved(Focusable *win) {
         remove(*win);
 }
 
-void FocusableList::checkUpdate(Focusable &win) {
+void FocusableList::checkUpdate(Focusable &win, unsigned int changed_props) {
+    if (!(m_pat->dependencies() & changed_props))
+        return;
+
     if (contains(win)) {
         if (!m_pat->match(win)) {
             m_list.remove(&win);
+            m_members.erase(&win);
             m_pat->removeMatch();
             m_removesig.emit(&win);
         }
@@ -164,7 +212,8 @@ void FocusableList::checkUpdate(Focusable &win) {
 
 // returns whether or not the window was moved
 bool FocusableList::insertFromParent(Focusable &win) {
-    const Focusables list = m_parent->clientList();
+    m_members.insert(&win);
+    const Focusables &list = m_parent->clientList();
     Focusables::const_iterator p_it = list.begin(), p_it_end = list.end();
     Focusables::iterator our_it = m_list.begin(), our_it_end = m_list.end();
     // walk through our list looking for corresponding entries in
@@ -189,11 +238,12 @@ void FocusableList::addMatching() {
     if (!m_parent)
         return;
 
-    const Focusables list = m_parent->clientList();
+    const Focusables &list = m_parent->clientList();
     Focusables::const_iterator it = list.begin(), it_end = list.end();
     for (; it != it_end; ++it) {
         if (m_pat->match(**it)) {
             m_list.push_back(*it);
+            m_members.insert(*it);
             m_pat->addMatch();
         }
         attachSignals(**it);
@@ -202,12 +252,14 @@ void FocusableList::addMatching() {
 
 void FocusableList::pushFront(Focusable &win) {
     m_list.push_front(&win);
+    m_members.insert(&win);
     attachSignals(win);
     m_addsig.emit(&win);
 }
 
 void FocusableList::pushBack(Focusable &win) {
     m_list.push_back(&win);
+    m_members.insert(&win);
     attachSignals(win);
     m_addsig.emit(&win);
 }
@@ -241,11 +293,12 @@ void FocusableList::remove(Focusable &win) {
         return;
     }
     m_list.remove(&win);
+    m_members.erase(&win);
     m_removesig.emit(&win);
 }
 
 void FocusableList::updateTitle(Focusable& win) {
-    checkUpdate(win);
+    checkUpdate(win, win.fbwindow() == &win ? WINDOW_TITLE_PROPS : CLIENT_TITLE_PROPS);
 }
 #include "Debug.hh"
 
@@ -260,12 +313,18 @@ void FocusableList::attachSignals(Focusable &win) {
     if (! tracker) {
         // we have not attached to this window yet
         tracker.reset(new SignalTracker);
-        tracker->join(win.titleSig(), MemFunSelectArg1(*this, &FocusableList::updateTitle));
+        // only listen to what the pattern can see
+        const unsigned int deps = m_pat->dependencies();
+        if (deps & WINDOW_TITLE_PROPS)
+            tracker->join(win.titleSig(), MemFunSelectArg1(*this, &FocusableList::updateTitle));
         tracker->join(win.dieSig(), MemFun(*this, &FocusableList::remove));
         if(fbwin) {
-            tracker->join(fbwin->workspaceSig(), MemFun(*this, &FocusableList::windowUpdated));
-            tracker->join(fbwin->stateSig(), MemFun(*this, &FocusableList::windowUpdated));
-            tracker->join(fbwin->layerSig(), MemFun(*this, &FocusableList::windowUpdated));
+            if (deps & WORKSPACE_PROPS)
+                tracker->join(fbwin->workspaceSig(), MemFun(*this, &FocusableList::windowWorkspaceChanged));
+            if (deps & STATE_PROPS)
+                tracker->join(fbwin->stateSig(), MemFun(*this, &FocusableList::windowStateChanged));
+            if (deps & LAYER_PROPS)
+                tracker->join(fbwin->layerSig(), MemFun(*this, &FocusableList::windowLayerChanged));
             // TODO: can't watch (head=...) yet
         }
     }
@@ -274,6 +333,7 @@ void FocusableList::attachSignals(Focusable &win) {
 void FocusableList::reset() {
     m_signal_map.clear();
     m_list.clear();
+    m_members.clear();
     m_pat->resetMatches();
     if (m_parent)
         addMatching();
@@ -281,9 +341,7 @@ void FocusableList::reset() {
 }
 
 bool FocusableList::contains(const Focusable &win) const {
-    Focusables::const_iterator it = m_list.begin(), it_end = m_list.end();
-    it = std::find(it, it_end, &win);
-    return (it != it_end);
+    return m_members.find(&win) != m_members.end();
 }
 
 Focusable *FocusableList::find(const ClientPattern &pat) const {
@@ -29,6 +29,7 @@
 #include "ClientPattern.hh"
 
 #include <list>
+#include <set>
 #include <string>
 #include <memory>
 
@@ -87,7 +88,8 @@ public:
 private:
     void init();
     void addMatching();
-    void checkUpdate(Focusable &win);
+    /// re-match the window if the pattern depends on the changed properties
+    void checkUpdate(Focusable &win, unsigned int changed_props);
     bool insertFromParent(Focusable &win);
     void attachSignals(Focusable &win);
     void reset();
@@ -99,13 +101,17 @@ private:
     void parentOrderChanged(Focusable* win);
     void parentWindowAdded(Focusable* win);
     void parentWindowRemoved(Focusable* win);
-    void windowUpdated(FluxboxWindow &fbwin);
+    void windowWorkspaceChanged(FluxboxWindow &fbwin);
+    void windowStateChanged(FluxboxWindow &fbwin);
+    void windowLayerChanged(FluxboxWindow &fbwin);
+    void windowUpdated(FluxboxWindow &fbwin, unsigned int changed_props);
 
 
     std::auto_ptr<ClientPattern> m_pat;
     const FocusableList *m_parent;
     BScreen &m_screen;
     std::list<Focusable *> m_list;
+    std::set<const Focusable *> m_members; ///< same windows as m_list, for lookup
 
     FbTk::Signal<Focusable *> m_ordersig, m_addsig, m_removesig;
     FbTk::Signal<> m_resetsig;
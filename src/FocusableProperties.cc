@@ -0,0 +1,159 @@
+// FocusableProperties.cc for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "FocusableProperties.hh"
+
+#include "fluxbox.hh"
+#include "FocusControl.hh"
+#include "Layer.hh"
+#include "Screen.hh"
+#include "WinClient.hh"
+#include "Workspace.hh"
+
+#include "FbTk/StringUtil.hh"
+
+// the parts of ClientPattern which need to know about windows live here,
+// the pattern itself only deals with ClientPattern::Properties
+
+bool ClientPattern::match(const Focusable &win) const {
+    FocusableProperties props(win);
+    return match(props);
+}
+
+FbTk::FbString ClientPattern::getProperty(WinProperty prop, const Focusable &client) {
+    FocusableProperties props(client);
+    return props.text(prop);
+}
+
+bool FocusableProperties::current(ClientPattern::WinProperty prop,
+                                  FbTk::FbString &value) {
+    if (prop == ClientPattern::WORKSPACE) {
+        value = FbTk::StringUtil::number2String(m_win.screen().currentWorkspaceID());
+        return true;
+    }
+    if (prop == ClientPattern::WORKSPACENAME) {
+        const Workspace *w = m_win.screen().currentWorkspace();
+        if (!w)
+            return false;
+        value = w->name();
+        return true;
+    }
+
+    WinClient *focused = FocusControl::focusedWindow();
+    if (!focused)
+        return false;
+    value = ClientPattern::getProperty(prop, *focused);
+    return true;
+}
+
+int FocusableProperties::mouseHead() {
+    return m_win.screen().getCurrHead();
+}
+
+FbTk::FbString FocusableProperties::xpropText(Atom prop) {
+    return m_win.getTextProperty(prop);
+}
+
+long FocusableProperties::xpropCardinal(Atom prop) {
+    return m_win.getCardinalProperty(prop);
+}
+
+int FocusableProperties::fetchNumber(ClientPattern::WinProperty prop) {
+
+    // we need this for some of the window properties
+    const FluxboxWindow *fbwin = m_win.fbwindow();
+
+    switch (prop) {
+    case ClientPattern::WORKSPACE:
+        return fbwin ? fbwin->workspaceNumber() : m_win.screen().currentWorkspaceID();
+    case ClientPattern::HEAD:
+        return fbwin ? m_win.screen().getHead(fbwin->fbWindow()) : -1;
+    case ClientPattern::SCREEN:
+        return m_win.screen().screenNumber();
+    default:
+        return -1;
+    }
+}
+
+FbTk::FbString FocusableProperties::fetchText(ClientPattern::WinProperty prop) {
+
+    FbTk::FbString result;
+
+    // we need this for some of the window properties
+    const FluxboxWindow *fbwin = m_win.fbwindow();
+
+    switch (prop) {
+    case ClientPattern::TITLE:
+        result = m_win.title().logical();
+        break;
+    case ClientPattern::CLASS:
+        result = m_win.getWMClassClass();
+        break;
+    case ClientPattern::ROLE:
+        result = m_win.getWMRole();
+        break;
+    case ClientPattern::TRANSIENT:
+        result = m_win.isTransient() ? "yes" : "no";
+        break;
+    case ClientPattern::MAXIMIZED:
+        result = (fbwin && fbwin->isMaximized()) ? "yes" : "no";
+        break;
+    case ClientPattern::MINIMIZED:
+        result = (fbwin && fbwin->isIconic()) ? "yes" : "no";
+        break;
+    case ClientPattern::SHADED:
+        result = (fbwin && fbwin->isShaded()) ? "yes" : "no";
+        break;
+    case ClientPattern::STUCK:
+        result = (fbwin && fbwin->isStuck()) ? "yes" : "no";
+        break;
+    case ClientPattern::FOCUSHIDDEN:
+        result = (fbwin && fbwin->isFocusHidden()) ? "yes" : "no";
+        break;
+    case ClientPattern::ICONHIDDEN:
+        result = (fbwin && fbwin->isIconHidden()) ? "yes" : "no";
+        break;
+    case ClientPattern::WORKSPACENAME: {
+        const Workspace *w = (fbwin ?
+                m_win.screen().getWorkspace(fbwin->workspaceNumber()) :
+                m_win.screen().currentWorkspace());
+        if (w) {
+            result = w->name();
+        }
+        break;
+    }
+    case ClientPattern::LAYER:
+        if (fbwin) {
+            result = ::ResourceLayer::getString(fbwin->layerNum());
+        }
+        break;
+    case ClientPattern::URGENT:
+        result = Fluxbox::instance()->attentionHandler()
+                .isDemandingAttention(m_win) ? "yes" : "no";
+        break;
+
+    case ClientPattern::NAME:
+    default:
+        result = m_win.getWMClassName();
+        break;
+    }
+    return result;
+}
@@ -1,5 +1,5 @@
-// SearchResult.hh for FbTk - Fluxbox Toolkit
-// Copyright (c) 2007 Fluxbox Team (fluxgen at fluxbox dot org)
+// FocusableProperties.hh for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
 //
 // Permission is hereby granted, free of charge, to any person obtaining a
 // copy of this software and associated documentation files (the "Software"),
@@ -13,43 +13,35 @@
 //
 // THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
 // IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
 // THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 // LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
 // DEALINGS IN THE SOFTWARE.
 
-#ifndef FBTK_SEARCHRESULT_HH
-#define FBTK_SEARCHRESULT_HH
+#ifndef FOCUSABLEPROPERTIES_HH
+#define FOCUSABLEPROPERTIES_HH
 
-#include <vector>
-#include <string>
+#include "ClientPattern.hh"
 
-namespace FbTk {
-
-class ITypeAheadable;
-
-class SearchResult {
+/**
+ * The properties of a Focusable for matching it against ClientPatterns
+ */
+class FocusableProperties: public ClientPattern::Properties {
 public:
-    typedef std::vector < ITypeAheadable* > BaseItems;
-    typedef BaseItems::iterator BaseItemsIt;
-
-    SearchResult(const std::string &to_search_for):
-        m_seeked_string(to_search_for) { }
+    explicit FocusableProperties(const Focusable &win): m_win(win) { }
 
-    void add(ITypeAheadable* item) { m_results.push_back(item); }
-    size_t size() const { return m_results.size(); }
-    const BaseItems& result() const { return m_results; }
-    const std::string& seekedString() const { return m_seeked_string; }
+    bool current(ClientPattern::WinProperty prop, FbTk::FbString &value);
+    int mouseHead();
+    FbTk::FbString xpropText(Atom prop);
+    long xpropCardinal(Atom prop);
 
-    void seek();
+protected:
+    FbTk::FbString fetchText(ClientPattern::WinProperty prop);
+    int fetchNumber(ClientPattern::WinProperty prop);
 
 private:
-    BaseItems m_results;
-    std::string m_seeked_string;
-
+    const Focusable &m_win;
 };
 
-} // end namespace FbTk
-
-#endif // FBTK_SEARCHRESULT_HH
+#endif // FOCUSABLEPROPERTIES_HH
@@ -155,14 +155,16 @@ void IconButton::reconfigTheme() {
 
     setAlpha(parent()->alpha());
 
+    // text first, setting the background renders the label
+    setGC(m_theme->text().textGC());
+    setFont(m_theme->text().font());
+    setJustify(m_theme->text().justify());
+
     if (m_pm != 0)
         setBackgroundPixmap(m_pm);
     else
         setBackgroundColor(m_theme->texture().color());
 
-    setGC(m_theme->text().textGC());
-    setFont(m_theme->text().font());
-    setJustify(m_theme->text().justify());
     setBorderWidth(m_theme->border().width());
     setBorderColor(m_theme->border().color());
 
@@ -224,6 +226,9 @@ void IconButton::refreshEverything(bool setup) {
     } else
         m_icon_mask = 0;
 
+    // the text starts after the icon
+    invalidateLabel();
+
 #ifdef SHAPE
 
     XShapeCombineMask(display,
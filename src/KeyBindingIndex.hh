@@ -0,0 +1,101 @@
+// KeyBindingIndex.hh for Fluxbox - an X11 Window manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef KEYBINDINGINDEX_HH
+#define KEYBINDINGINDEX_HH
+
+#include <map>
+#include <vector>
+
+/**
+ * Lookup table for the children of a node in the keytree.
+ *
+ * Bindings are bucketed by (type, mod, key, isdouble); a lookup only has
+ * to check the context of the few bindings that share the signature of the
+ * event. Within a bucket the insertion order is kept, so the first binding
+ * added still wins, just like with a linear scan of the keylist.
+ *
+ * 'Ref' is a pointer-like type to something with the public members
+ * type, mod, key, context and isdouble.
+ */
+template <typename Ref>
+class KeyBindingIndex {
+public:
+
+    void insert(const Ref &binding) {
+        m_buckets[Signature(binding->type, binding->mod,
+                            binding->key, binding->isdouble)].push_back(binding);
+    }
+
+    void clear() { m_buckets.clear(); }
+    bool empty() const { return m_buckets.empty(); }
+
+    /**
+     * @param mods must already be isolated from non-modifier bits
+     * @param context bitwise-or of the contexts the event happened in
+     * @return the first matching binding or Ref() if there is none
+     */
+    Ref find(int type, unsigned int mods, unsigned int key,
+             int context, bool isdouble) const {
+
+        typename Buckets::const_iterator it =
+            m_buckets.find(Signature(type, mods, key, isdouble));
+        if (it == m_buckets.end())
+            return Ref();
+
+        typename Bucket::const_iterator b = it->second.begin();
+        typename Bucket::const_iterator b_end = it->second.end();
+        for (; b != b_end; ++b) {
+            if (((*b)->context & context) > 0)
+                return *b;
+        }
+        return Ref();
+    }
+
+private:
+
+    struct Signature {
+        Signature(int type_, unsigned int mod_, unsigned int key_, bool isdouble_) :
+            type(type_), mod(mod_), key(key_), isdouble(isdouble_) { }
+
+        bool operator < (const Signature &other) const {
+            if (key != other.key)
+                return key < other.key;
+            if (mod != other.mod)
+                return mod < other.mod;
+            if (type != other.type)
+                return type < other.type;
+            return isdouble < other.isdouble;
+        }
+
+        int type;
+        unsigned int mod;
+        unsigned int key;
+        bool isdouble;
+    };
+
+    typedef std::vector<Ref> Bucket;
+    typedef std::map<Signature, Bucket> Buckets;
+
+    Buckets m_buckets;
+};
+
+#endif // KEYBINDINGINDEX_HH
@@ -0,0 +1,216 @@
+// KeyBindingLine.cc for fluxbox
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "KeyBindingLine.hh"
+#include "Keys.hh"
+
+#include "FbTk/KeyUtil.hh"
+#include "FbTk/StringUtil.hh"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#ifdef HAVE_CCTYPE
+  #include <cctype>
+#else
+  #include <ctype.h>
+#endif	// HAVE_CCTYPE
+
+#ifdef HAVE_CSTRING
+  #include <cstring>
+#else
+  #include <string.h>
+#endif
+
+#include <X11/Xlib.h>
+
+#include <algorithm>
+
+namespace {
+
+// candidate for FbTk::StringUtil ?
+int extractKeyFromString(const std::string& in, const char* start_pattern, unsigned int& key) {
+
+    int ret = 0;
+
+    if (strstr(in.c_str(), start_pattern) != 0) {
+
+        unsigned int tmp_key = 0;
+        if (FbTk::StringUtil::extractNumber(in.substr(strlen(start_pattern)), tmp_key)) {
+
+            key = tmp_key;
+            ret = 1;
+        }
+    }
+
+    return ret;
+}
+
+void clear(KeyBindingLine::Key &k) {
+    k.type = 0;
+    k.mod = 0;
+    k.key = 0;
+    k.sym = NoSymbol;
+    k.key_str.clear();
+    k.context = 0;
+    k.isdouble = false;
+}
+
+} // end of anonymous namespace
+
+bool KeyBindingLine::parse(FbTk::Tokenizer &line) {
+
+    m_keymode.clear();
+    m_keys.clear();
+    m_command = FbTk::Token();
+
+    FbTk::Token token;
+    // must have at least 1 argument
+    if (!line.word(token))
+        return true; // empty lines are valid.
+
+    if (token[0] == '#' || token[0] == '!' ) //the line is commented
+        return true; // still a valid line.
+
+    if (token.back() == ':') {
+        token.assignTo(m_keymode);
+        if (!line.word(token))
+            return false;
+    }
+
+    Key current;
+    clear(current);
+    unsigned int &key = current.key, &mod = current.mod;
+    int &type = current.type, &context = current.context;
+    bool &isdouble = current.isdouble;
+
+    // for each argument
+    do {
+
+        token.assignTo(m_val);
+        m_arg = m_val;
+        const std::string &arg = m_arg;
+        std::transform(m_arg.begin(), m_arg.end(), m_arg.begin(), tolower);
+
+        if (arg[0] != ':') { // parse key(s)
+
+            int tmpmod = FbTk::KeyUtil::getModifier(arg.c_str());
+            if(tmpmod)
+                mod |= tmpmod; //If it's a modifier
+            else if (arg == "ondesktop")
+                context |= Keys::ON_DESKTOP;
+            else if (arg == "ontoolbar")
+                context |= Keys::ON_TOOLBAR;
+            else if (arg == "onwindow")
+                context |= Keys::ON_WINDOW;
+            else if (arg == "ontitlebar")
+                context |= Keys::ON_TITLEBAR;
+            else if (arg == "onwindowborder")
+                context |= Keys::ON_WINDOWBORDER;
+            else if (arg == "onleftgrip")
+                context |= Keys::ON_LEFTGRIP;
+            else if (arg == "onrightgrip")
+                context |= Keys::ON_RIGHTGRIP;
+            else if (arg == "double")
+                isdouble = true;
+            else if (arg != "none") {
+                if (arg == "focusin") {
+                    context = Keys::ON_WINDOW;
+                    mod = key = 0;
+                    type = FocusIn;
+                } else if (arg == "focusout") {
+                    context = Keys::ON_WINDOW;
+                    mod = key = 0;
+                    type = FocusOut;
+                } else if (arg == "changeworkspace") {
+                    context = Keys::ON_DESKTOP;
+                    mod = key = 0;
+                    type = FocusIn;
+                } else if (arg == "mouseover") {
+                    type = EnterNotify;
+                    if (!(context & (Keys::ON_WINDOW|Keys::ON_TOOLBAR)))
+                        context |= Keys::ON_WINDOW;
+                    key = 0;
+                } else if (arg == "mouseout") {
+                    type = LeaveNotify;
+                    if (!(context & (Keys::ON_WINDOW|Keys::ON_TOOLBAR)))
+                        context |= Keys::ON_WINDOW;
+                    key = 0;
+
+                // check if it's a mouse button
+                } else if (extractKeyFromString(arg, "mouse", key)) {
+                    type = ButtonPress;
+
+                    // fluxconf mangles things like OnWindow Mouse# to Mouse#ow
+                    if (strstr(arg.c_str(), "top"))
+                        context = Keys::ON_DESKTOP;
+                    else if (strstr(arg.c_str(), "ebar"))
+                        context = Keys::ON_TITLEBAR;
+                    else if (strstr(arg.c_str(), "bar"))
+                        context = Keys::ON_TOOLBAR;
+                    else if (strstr(arg.c_str(), "ow"))
+                        context = Keys::ON_WINDOW;
+                } else if (extractKeyFromString(arg, "click", key)) {
+                    type = ButtonRelease;
+                } else if (extractKeyFromString(arg, "move", key)) {
+                    type = MotionNotify;
+
+                } else if ((current.sym = XStringToKeysym(m_val.c_str())) != NoSymbol) {
+                    // convert from string symbol, Keys finds the key code
+                    type = KeyPress;
+                    current.key_str = m_val;
+                    // used if the keysym has no key code
+                    FbTk::StringUtil::extractNumber(arg, key);
+
+                // keycode covers the following three two-byte cases:
+                // 0x       - hex
+                // +[1-9]   - number between +1 and +9
+                // numbers 10 and above
+                //
+                } else {
+                    FbTk::StringUtil::extractNumber(arg, key);
+                    type = KeyPress;
+                }
+
+                if (key == 0 && current.sym == NoSymbol &&
+                    (type == KeyPress || type == ButtonPress || type == ButtonRelease))
+                    return false;
+
+                if (type != ButtonPress)
+                    isdouble = false;
+
+                m_keys.push_back(current);
+                clear(current);
+            }
+
+        } else { // parse command line
+            if (m_keys.empty() || mod)
+                return false;
+
+            // the command is the rest of the line, +1 to skip ':'
+            m_command = FbTk::Token(token.begin() + 1, line.line().end());
+            return true;
+        }  // end if
+    } while (line.word(token));
+
+    return false;
+}
@@ -0,0 +1,74 @@
+// KeyBindingLine.hh for fluxbox
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef KEYBINDINGLINE_HH
+#define KEYBINDINGLINE_HH
+
+#include "FbTk/Tokenizer.hh"
+
+#include <X11/X.h>
+#include <string>
+#include <vector>
+
+/**
+ * One line of the keys file, split into its keys and its command.
+ *
+ * This is the part of Keys::addBinding() that doesn't need a display.
+ * Key names are only turned into keysyms; Keys looks up their keycodes
+ * when it adds the binding to the keytree.
+ */
+class KeyBindingLine {
+public:
+    /// one key, button or event of a key chain
+    struct Key {
+        int type; ///< KeyPress, ButtonPress, ...
+        unsigned int mod;
+        unsigned int key; ///< button number, key code or 0
+        KeySym sym; ///< NoSymbol unless the key was given by name
+        std::string key_str; ///< the name of sym
+        int context; ///< bitwise-or of Keys::ON_DESKTOP, ...
+        bool isdouble;
+    };
+    typedef std::vector<Key> KeyList;
+
+    /**
+     * Parses the current line of the tokenizer.
+     * Blank lines and comments are valid and leave keys() empty.
+     * @return false if the line isn't a valid binding
+     */
+    bool parse(FbTk::Tokenizer &line);
+
+    /// "name:" if the binding is for a keymode other than the default one
+    const std::string &keyMode() const { return m_keymode; }
+    /// the chain of keys, in the order they have to be pressed
+    const KeyList &keys() const { return m_keys; }
+    /// the command, without its leading ':'
+    const FbTk::Token &command() const { return m_command; }
+
+private:
+    std::string m_keymode;
+    KeyList m_keys;
+    FbTk::Token m_command;
+    // reused for every argument
+    std::string m_val, m_arg;
+};
+
+#endif // KEYBINDINGLINE_HH
@@ -20,6 +20,8 @@
 // DEALINGS IN THE SOFTWARE.
 
 #include "Keys.hh"
+#include "KeyBindingIndex.hh"
+#include "KeyBindingLine.hh"
 
 #include "fluxbox.hh"
 #include "Screen.hh"
@@ -38,6 +40,7 @@
 #include "FbTk/I18n.hh"
 #include "FbTk/AutoReloadHelper.hh"
 #include "FbTk/STLUtil.hh"
+#include "FbTk/Tokenizer.hh"
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -93,8 +96,8 @@
 #include <X11/XKBlib.h>
 
 #include <iostream>
-#include <fstream>
 #include <list>
+#include <algorithm>
 #include <vector>
 #include <memory>
 
@@ -102,33 +105,10 @@ using std::cerr;
 using std::endl;
 using std::string;
 using std::vector;
-using std::ifstream;
 using std::pair;
 
 using FbTk::STLUtil::destroyAndClearSecond;
 
-namespace {
-
-// candidate for FbTk::StringUtil ?
-int extractKeyFromString(const std::string& in, const char* start_pattern, unsigned int& key) {
-
-    int ret = 0;
-
-    if (strstr(in.c_str(), start_pattern) != 0) {
-
-        unsigned int tmp_key = 0;
-        if (FbTk::StringUtil::extractNumber(in.substr(strlen(start_pattern)), tmp_key)) {
-
-            key = tmp_key;
-            ret = 1;
-        }
-    }
-
-    return ret;
-}
-
-} // end of anonymous namespace
-
 // helper class 'keytree'
 class Keys::t_key {
 public:
@@ -145,15 +125,21 @@ public:
                 int context_, bool isdouble_) {
         // t_key ctor sets context_ of 0 to GLOBAL, so we must here too
         context_ = context_ ? context_ : GLOBAL;
+        mod_ = FbTk::KeyUtil::instance().isolateModifierMask(mod_);
+        return index.find(type_, mod_, key_, context_, isdouble_);
+    }
+
+    void add(const RefKey &k) {
+        keylist.push_back(k);
+        index.insert(k);
+    }
+
+    /// rebuild the lookup table, needed when key codes of children change
+    void reindex() {
+        index.clear();
         keylist_t::iterator it = keylist.begin(), it_end = keylist.end();
-        for (; it != it_end; it++) {
-            if (*it && (*it)->type == type_ && (*it)->key == key_ &&
-                ((*it)->context & context_) > 0 &&
-                isdouble_ == (*it)->isdouble && (*it)->mod ==
-                FbTk::KeyUtil::instance().isolateModifierMask(mod_))
-                return *it;
-        }
-        return RefKey();
+        for (; it != it_end; ++it)
+            index.insert(*it);
     }
 
     // member variables
@@ -167,6 +153,7 @@ public:
     FbTk::RefCount<FbTk::Command<void> > m_command;
 
     keylist_t keylist;
+    KeyBindingIndex<RefKey> index;
 };
 
 Keys::t_key::t_key(int type_, unsigned int mod_, unsigned int key_,
@@ -207,15 +194,12 @@ void Keys::deleteTree() {
     saved_keymode.reset();
 }
 
-// keys are only grabbed in global context
-void Keys::grabKey(unsigned int key, unsigned int mod) {
-    WindowMap::iterator it = m_window_map.begin();
-    WindowMap::iterator it_end = m_window_map.end();
-
-    for (; it != it_end; ++it) {
-        if ((it->second & Keys::GLOBAL) > 0)
-            FbTk::KeyUtil::grabKey(key, mod, it->first);
-    }
+bool Keys::Grab::operator < (const Grab &other) const {
+    if (type != other.type)
+        return type < other.type;
+    if (code != other.code)
+        return code < other.code;
+    return mod < other.mod;
 }
 
 // keys are only grabbed in global context
@@ -229,18 +213,6 @@ void Keys::ungrabKeys() {
     }
 }
 
-// ON_DESKTOP context doesn't need to be grabbed
-void Keys::grabButton(unsigned int button, unsigned int mod, int context) {
-    WindowMap::iterator it = m_window_map.begin();
-    WindowMap::iterator it_end = m_window_map.end();
-
-    for (; it != it_end; ++it) {
-        if ((context & it->second & ~Keys::ON_DESKTOP) > 0)
-            FbTk::KeyUtil::grabButton(button, mod, it->first,
-                                      ButtonPressMask|ButtonReleaseMask|ButtonMotionMask);
-    }
-}
-
 void Keys::ungrabButtons() {
     WindowMap::iterator it = m_window_map.begin();
     WindowMap::iterator it_end = m_window_map.end();
@@ -250,29 +222,95 @@ void Keys::ungrabButtons() {
 }
 
 void Keys::grabWindow(Window win) {
+    // make sure the window is in our list
+    if (m_window_map.find(win) == m_window_map.end())
+        return;
+
+    syncGrabs(win, true);
+}
+
+void Keys::neededGrabs(int win_context, GrabSet &grabs) const {
     if (!m_keylist)
         return;
 
-    // make sure the window is in our list
-    WindowMap::iterator win_it = m_window_map.find(win);
+    t_key::keylist_t::const_iterator it = m_keylist->keylist.begin();
+    t_key::keylist_t::const_iterator it_end = m_keylist->keylist.end();
+    for (; it != it_end; ++it) {
+        const RefKey &t = *it;
+        if (t->type == KeyPress) {
+            // keys are only grabbed in global context, key code 0 would
+            // be AnyKey
+            if ((win_context & Keys::GLOBAL) > 0 && t->key != 0)
+                grabs.insert(Grab(KeyPress, t->key, t->mod));
+        // ON_DESKTOP buttons don't need to be grabbed
+        } else if ((win_context & t->context & ~Keys::ON_DESKTOP) > 0 &&
+                   (t->type == ButtonPress || t->type == ButtonRelease ||
+                    t->type == MotionNotify)) {
+            grabs.insert(Grab(ButtonPress, t->key, t->mod));
+        }
+    }
+}
+
+/**
+ * Only the difference between the grabs we hold and the grabs we need is
+ * sent to the server, so reloading an unchanged keys file or switching
+ * between similar keymodes costs (almost) nothing.
+ *
+ * Button grabs of the event handler (e.g. click to focus) may cover the
+ * same buttons with AnyModifier, so whenever one of our button grabs goes
+ * away, all buttons get ungrabbed and the handler grabs its own again
+ * before ours are added on top.
+ */
+void Keys::syncGrabs(Window win, bool regrab_all) {
+    WindowMap::const_iterator win_it = m_window_map.find(win);
     if (win_it == m_window_map.end())
         return;
 
-    m_handler_map[win]->grabButtons();
-    t_key::keylist_t::iterator it = m_keylist->keylist.begin();
-    t_key::keylist_t::iterator it_end = m_keylist->keylist.end();
+    GrabSet needed;
+    neededGrabs(win_it->second, needed);
+    GrabSet &active = m_grabs[win];
+
+    if (regrab_all) {
+        FbTk::KeyUtil::ungrabKeys(win);
+        FbTk::KeyUtil::ungrabButtons(win);
+        m_handler_map[win]->grabButtons();
+        active.clear();
+    }
+
+    bool buttons_removed = false;
+    GrabSet::iterator it = active.begin(), it_end = active.end();
     for (; it != it_end; ++it) {
-        // keys are only grabbed in global context
-        if ((win_it->second & Keys::GLOBAL) > 0 && (*it)->type == KeyPress)
-            FbTk::KeyUtil::grabKey((*it)->key, (*it)->mod, win);
-        // ON_DESKTOP buttons don't need to be grabbed
-        else if ((win_it->second & (*it)->context & ~Keys::ON_DESKTOP) > 0) {
+        if (needed.find(*it) != needed.end())
+            continue;
+        if (it->type == KeyPress)
+            FbTk::KeyUtil::ungrabKey(it->code, it->mod, win);
+        else
+            buttons_removed = true;
+    }
 
-            if ((*it)->type == ButtonPress || (*it)->type == ButtonRelease || (*it)->type == MotionNotify) {
-                FbTk::KeyUtil::grabButton((*it)->key, (*it)->mod, win, ButtonPressMask|ButtonReleaseMask|ButtonMotionMask);
-            }
+    if (buttons_removed) {
+        FbTk::KeyUtil::ungrabButtons(win);
+        m_handler_map[win]->grabButtons();
+        // drop the button grabs, they get grabbed again below
+        GrabSet keys_only;
+        for (it = active.begin(); it != it_end; ++it) {
+            if (it->type == KeyPress)
+                keys_only.insert(*it);
         }
+        active.swap(keys_only);
+    }
+
+    for (it = needed.begin(), it_end = needed.end(); it != it_end; ++it) {
+        if (active.find(*it) != active.end())
+            continue;
+        if (it->type == KeyPress)
+            FbTk::KeyUtil::grabKey(it->code, it->mod, win);
+        else
+            FbTk::KeyUtil::grabButton(it->code, it->mod, win,
+                                      ButtonPressMask|ButtonReleaseMask|ButtonMotionMask);
     }
+
+    active.swap(needed);
 }
 
 /**
@@ -296,8 +334,8 @@ void Keys::reload() {
     }
 
     // open the file
-    ifstream infile(m_filename.c_str());
-    if (!infile) {
+    FbTk::Tokenizer infile;
+    if (!infile.open(m_filename)) {
         if (firstload)
             loadDefaults();
         return; // failed to open file
@@ -308,23 +346,15 @@ void Keys::reload() {
 
     m_map["default:"] = FbTk::makeRef<t_key>();
 
-    unsigned int current_line = 0; //so we can tell the user where the fault is
-
-    while (!infile.eof()) {
-        string linebuffer;
-
-        getline(infile, linebuffer);
-
-        current_line++;
-
-        if (!addBinding(linebuffer)) {
+    while (infile.nextLine()) {
+        if (!addBinding(infile)) {
             _FB_USES_NLS;
             cerr<<_FB_CONSOLETEXT(Keys, InvalidKeyMod,
                           "Keys: Invalid key/modifier on line",
                           "A bad key/modifier string was found on line (number following)")<<" "<<
-                current_line<<"): "<<linebuffer<<endl;
+                infile.row()<<"): "<<infile.line().str()<<endl;
         }
-    } // end while eof
+    }
 
     keyMode("default");
 }
@@ -353,164 +383,79 @@ void Keys::loadDefaults() {
 }
 
 bool Keys::addBinding(const string &linebuffer) {
+    FbTk::Tokenizer line(linebuffer.data(), linebuffer.size());
+    line.nextLine();
+    return addBinding(line);
+}
 
-    vector<string> val;
-    // Parse arguments
-    FbTk::StringUtil::stringtok(val, linebuffer.c_str());
-
-    // must have at least 1 argument
-    if (val.empty())
-        return true; // empty lines are valid.
+bool Keys::addBinding(FbTk::Tokenizer &line) {
 
-    if (val[0][0] == '#' || val[0][0] == '!' ) //the line is commented
-        return true; // still a valid line.
+    KeyBindingLine &parsed = m_parsed_line;
+    bool valid = parsed.parse(line);
 
-    unsigned int key = 0, mod = 0;
-    int type = 0, context = 0;
-    bool isdouble = false;
-    size_t argc = 0;
     RefKey current_key = m_map["default:"];
+    if (!parsed.keyMode().empty()) {
+        RefKey &mode = m_map[parsed.keyMode()];
+        if (!mode)
+            mode = FbTk::makeRef<t_key>();
+        current_key = mode;
+    }
+
+    if (!valid)
+        return false;
+    if (parsed.keys().empty())
+        return true; // empty or commented line
+
     RefKey first_new_keylist = current_key, first_new_key;
+    Display *display = FbTk::App::instance()->display();
+    static const std::string no_key_str;
 
-    if (val[0][val[0].length()-1] == ':') {
-        argc++;
-        keyspace_t::iterator it = m_map.find(val[0]);
-        if (it == m_map.end())
-            m_map[val[0]] = FbTk::makeRef<t_key>();
-        current_key = m_map[val[0]];
-    }
-    // for each argument
-    for (; argc < val.size(); argc++) {
-
-        std::string arg = FbTk::StringUtil::toLower(val[argc]);
-
-        if (arg[0] != ':') { // parse key(s)
-
-            std::string key_str;
-
-            int tmpmod = FbTk::KeyUtil::getModifier(arg.c_str());
-            if(tmpmod)
-                mod |= tmpmod; //If it's a modifier
-            else if (arg == "ondesktop")
-                context |= ON_DESKTOP;
-            else if (arg == "ontoolbar")
-                context |= ON_TOOLBAR;
-            else if (arg == "onwindow")
-                context |= ON_WINDOW;
-            else if (arg == "ontitlebar")
-                context |= ON_TITLEBAR;
-            else if (arg == "onwindowborder")
-                context |= ON_WINDOWBORDER;
-            else if (arg == "onleftgrip")
-                context |= ON_LEFTGRIP;
-            else if (arg == "onrightgrip")
-                context |= ON_RIGHTGRIP;
-            else if (arg == "double")
-                isdouble = true;
-            else if (arg != "none") {
-                if (arg == "focusin") {
-                    context = ON_WINDOW;
-                    mod = key = 0;
-                    type = FocusIn;
-                } else if (arg == "focusout") {
-                    context = ON_WINDOW;
-                    mod = key = 0;
-                    type = FocusOut;
-                } else if (arg == "changeworkspace") {
-                    context = ON_DESKTOP;
-                    mod = key = 0;
-                    type = FocusIn;
-                } else if (arg == "mouseover") {
-                    type = EnterNotify;
-                    if (!(context & (ON_WINDOW|ON_TOOLBAR)))
-                        context |= ON_WINDOW;
-                    key = 0;
-                } else if (arg == "mouseout") {
-                    type = LeaveNotify;
-                    if (!(context & (ON_WINDOW|ON_TOOLBAR)))
-                        context |= ON_WINDOW;
-                    key = 0;
-
-                // check if it's a mouse button
-                } else if (extractKeyFromString(arg, "mouse", key)) {
-                    type = ButtonPress;
-
-                    // fluxconf mangles things like OnWindow Mouse# to Mouse#ow
-                    if (strstr(arg.c_str(), "top"))
-                        context = ON_DESKTOP;
-                    else if (strstr(arg.c_str(), "ebar"))
-                        context = ON_TITLEBAR;
-                    else if (strstr(arg.c_str(), "bar"))
-                        context = ON_TOOLBAR;
-                    else if (strstr(arg.c_str(), "ow"))
-                        context = ON_WINDOW;
-                } else if (extractKeyFromString(arg, "click", key)) {
-                    type = ButtonRelease;
-                } else if (extractKeyFromString(arg, "move", key)) {
-                    type = MotionNotify;
-
-                } else if ((key = FbTk::KeyUtil::getKey(val[argc].c_str()))) { // convert from string symbol
-                    type = KeyPress;
-                    key_str = val[argc];
-
-                // keycode covers the following three two-byte cases:
-                // 0x       - hex
-                // +[1-9]   - number between +1 and +9
-                // numbers 10 and above
-                //
-                } else {
-                    FbTk::StringUtil::extractNumber(arg, key);
-                    type = KeyPress;
-                }
-
-                if (key == 0 && (type == KeyPress || type == ButtonPress || type == ButtonRelease))
-                    return false;
-
-                if (type != ButtonPress)
-                    isdouble = false;
-
-                if (!first_new_key) {
-                    first_new_keylist = current_key;
-                    current_key = current_key->find(type, mod, key, context,
-                                                    isdouble);
-                    if (!current_key) {
-                        first_new_key.reset( new t_key(type, mod, key, key_str, context,
-                                                  isdouble) );
-                        current_key = first_new_key;
-                    } else if (current_key->m_command) // already being used
-                        return false;
-                } else {
-                    RefKey temp_key( new t_key(type, mod, key, key_str, context,
-                                                isdouble) );
-                    current_key->keylist.push_back(temp_key);
-                    current_key = temp_key;
-                }
-                mod = 0;
-                key = 0;
-                type = 0;
-                context = 0;
-                isdouble = false;
+    KeyBindingLine::KeyList::const_iterator it = parsed.keys().begin();
+    KeyBindingLine::KeyList::const_iterator it_end = parsed.keys().end();
+    for (; it != it_end; ++it) {
+
+        unsigned int key = it->key;
+        const std::string *key_str = &no_key_str;
+        if (it->sym != NoSymbol) {
+            KeyCode code = XKeysymToKeycode(display, it->sym);
+            if (code) {
+                key = code;
+                key_str = &it->key_str;
             }
+        }
 
-        } else { // parse command line
-            if (!first_new_key)
+        if (key == 0 && (it->type == KeyPress || it->type == ButtonPress ||
+                         it->type == ButtonRelease))
+            return false;
+
+        if (!first_new_key) {
+            first_new_keylist = current_key;
+            current_key = current_key->find(it->type, it->mod, key,
+                                            it->context, it->isdouble);
+            if (!current_key) {
+                first_new_key.reset( new t_key(it->type, it->mod, key, *key_str,
+                                               it->context, it->isdouble) );
+                current_key = first_new_key;
+            } else if (current_key->m_command) // already being used
                 return false;
+        } else {
+            RefKey temp_key( new t_key(it->type, it->mod, key, *key_str,
+                                       it->context, it->isdouble) );
+            current_key->add(temp_key);
+            current_key = temp_key;
+        }
+    }
 
-            const char *str = FbTk::StringUtil::strcasestr(linebuffer.c_str(),
-                   val[argc].c_str());
-            if (str) // +1 to skip ':'
-                current_key->m_command.reset(FbTk::CommandParser<void>::instance().parse(str + 1));
-
-            if (!str || current_key->m_command == 0 || mod)
-                return false;
+    if (!first_new_key)
+        return false;
 
-            // success
-            first_new_keylist->keylist.push_back(first_new_key);
-            return true;
-        }  // end if
-    } // end for
+    current_key->m_command.reset(FbTk::CommandParser<void>::instance().parse(parsed.command().str()));
+    if (current_key->m_command == 0)
+        return false;
 
-    return false;
+    // success
+    first_new_keylist->add(first_new_key);
+    return true;
 }
 
 // return true if bound to a command, else false
@@ -605,6 +550,7 @@ void Keys::unregisterWindow(Window win) {
     FbTk::KeyUtil::ungrabButtons(win);
     m_handler_map.erase(win);
     m_window_map.erase(win);
+    m_grabs.erase(win);
 }
 
 /**
@@ -630,29 +576,32 @@ void Keys::keyMode(const string& keyMode) {
 }
 
 void Keys::setKeyMode(const FbTk::RefCount<t_key> &keyMode) {
-    ungrabKeys();
-    ungrabButtons();
-
-    // notify handlers that their buttons have been ungrabbed
-    HandlerMap::iterator h_it = m_handler_map.begin(),
-                         h_it_end  = m_handler_map.end();
-    for (; h_it != h_it_end; ++h_it)
-        h_it->second->grabButtons();
 
+    bool keycodes_changed = false;
     t_key::keylist_t::iterator it = keyMode->keylist.begin();
     t_key::keylist_t::iterator it_end = keyMode->keylist.end();
     for (; it != it_end; ++it) {
         RefKey t = *it;
-        if (t->type == KeyPress) {
-            if (!t->key_str.empty()) {
-                int key = FbTk::KeyUtil::getKey(t->key_str.c_str());
+        if (t->type == KeyPress && !t->key_str.empty()) {
+            unsigned int key = FbTk::KeyUtil::getKey(t->key_str.c_str());
+            if (t->key != key) {
                 t->key = key;
+                keycodes_changed = true;
             }
-            grabKey(t->key, t->mod);
-        } else {
-            grabButton(t->key, t->mod, t->context);
         }
     }
+    if (keycodes_changed)
+        keyMode->reindex();
     m_keylist = keyMode;
-}
 
+    // if the lock modifiers moved, the grabs we hold are not the ones
+    // we think we hold
+    const std::vector<unsigned int> &locks = FbTk::KeyUtil::instance().lockMasks();
+    bool regrab_all = (locks != m_grab_lockmasks);
+    m_grab_lockmasks = locks;
+
+    WindowMap::iterator w_it = m_window_map.begin(),
+                        w_it_end = m_window_map.end();
+    for (; w_it != w_it_end; ++w_it)
+        syncGrabs(w_it->first, regrab_all);
+}
@@ -22,18 +22,23 @@
 #ifndef KEYS_HH
 #define KEYS_HH
 
+#include "KeyBindingLine.hh"
+
 #include "FbTk/NotCopyable.hh"
 #include "FbTk/RefCount.hh"
 
 #include <X11/Xlib.h>
 #include <string>
 #include <map>
+#include <set>
+#include <vector>
 
 class WinClient;
 
 namespace FbTk {
     class EventHandler;
     class AutoReloadHelper;
+    class Tokenizer;
 }
 
 class Keys:private FbTk::NotCopyable  {
@@ -100,13 +105,30 @@ private:
     typedef std::map<Window, int> WindowMap;
     typedef std::map<Window, FbTk::EventHandler*> HandlerMap;
 
+    /// a passive grab we hold, without the ignored lock modifiers
+    struct Grab {
+        Grab(int type_, unsigned int code_, unsigned int mod_):
+            type(type_), code(code_), mod(mod_) { }
+        bool operator < (const Grab &other) const;
+        int type; // KeyPress or ButtonPress
+        unsigned int code; // key code or button number
+        unsigned int mod;
+    };
+    typedef std::set<Grab> GrabSet;
+    typedef std::map<Window, GrabSet> GrabMap;
+
     void deleteTree();
 
-    void grabKey(unsigned int key, unsigned int mod);
+    /// bind the current line of the tokenizer
+    bool addBinding(FbTk::Tokenizer &line);
+
     void ungrabKeys();
-    void grabButton(unsigned int button, unsigned int mod, int context);
     void ungrabButtons();
     void grabWindow(Window win);
+    /// the grabs the current keymode needs on a window with this context
+    void neededGrabs(int win_context, GrabSet &grabs) const;
+    /// bring the grabs of a window in line with the current keymode
+    void syncGrabs(Window win, bool regrab_all);
 
     // Load default keybindings for when there are errors loading the keys file
     void loadDefaults();
@@ -119,11 +141,15 @@ private:
     RefKey m_keylist;
     keyspace_t m_map;
 
+    KeyBindingLine m_parsed_line; ///< reused by addBinding
+
     RefKey next_key;
     RefKey saved_keymode;
 
     WindowMap m_window_map;
     HandlerMap m_handler_map;
+    GrabMap m_grabs;
+    std::vector<unsigned int> m_grab_lockmasks; // lock masks in m_grabs
 };
 
 #endif // KEYS_HH
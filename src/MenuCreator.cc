@@ -229,6 +229,14 @@ public:
     const string &label() const { return m_label.second; }
     const string &key() const { return m_key.second; }
     FbTk::Menu *menu() { return m_menu; }
+
+    /// append the item, with its recoded label, to items
+    void save(vector<FbTk::Parser::Item> &items) const {
+        items.push_back(m_key);
+        items.push_back(m_label);
+        items.push_back(m_cmd);
+        items.push_back(m_icon);
+    }
 private:
     FbTk::Parser::Item m_key, m_label, m_cmd, m_icon;
     FbTk::Menu *m_menu;
@@ -266,6 +274,96 @@ void parseMenu(FbTk::Parser &pars, FbTk::Menu &menu,
     }
 }
 
+/// hands out items that were read from a menu file before
+class ItemParser: public FbTk::Parser {
+public:
+    typedef vector<FbTk::Parser::Item> Items;
+
+    explicit ItemParser(const Items &items): m_items(items), m_pos(0) { }
+
+    bool open(const string &filename) { return false; }
+    void close() { }
+    bool eof() const { return m_pos >= m_items.size(); }
+    bool isLoaded() const { return true; }
+    int row() const { return 0; }
+    string line() const { return ""; }
+    FbTk::Parser &operator >> (FbTk::Parser::Item &out) {
+        out = nextItem();
+        return *this;
+    }
+    FbTk::Parser::Item nextItem() {
+        return eof() ? s_empty_item : m_items[m_pos++];
+    }
+
+private:
+    const Items &m_items;
+    size_t m_pos;
+};
+
+/**
+ * A [submenu] of a menu file. Until it is opened for the first time only
+ * the items of its block are kept, so includes, style directories and
+ * icons are not loaded for menus nobody looks at.
+ */
+class LazyMenu: public FbMenu {
+public:
+    LazyMenu(BScreen &screen, AutoReloadHelper *reloader):
+        FbMenu(screen.menuTheme(), screen.imageControl(),
+               *screen.layerManager().getLayer(ResourceLayer::MENU)),
+        m_reloader(reloader), m_populated(false) { }
+
+    /// read the items up to the [end] of the submenu
+    void record(FbTk::Parser &parser, FbTk::StringConvertor &labelconvertor) {
+        if (!s_encoding_stack.empty())
+            m_encoding = s_encoding_stack.back();
+
+        ParseItem pitem(0);
+        int depth = 0;
+        while (!parser.eof()) {
+            pitem.load(parser, labelconvertor);
+            if (pitem.key() == "end") {
+                if (depth == 0)
+                    break;
+                --depth;
+            } else if (pitem.key() == "submenu") {
+                ++depth;
+            } else if (pitem.key() == "encoding") {
+                // later labels have to be recoded right now
+                startEncoding(pitem.command());
+            } else if (pitem.key() == "endencoding") {
+                endEncoding();
+            }
+            pitem.save(m_items);
+        }
+    }
+
+protected:
+    void populate() {
+        if (m_populated)
+            return;
+        m_populated = true;
+
+        // the labels have been recoded while recording
+        FbTk::StringConvertor recoded(FbTk::StringConvertor::ToFbString);
+        ItemParser parser(m_items);
+
+        startFile();
+        if (!m_encoding.empty())
+            startEncoding(m_encoding);
+        parseMenu(parser, *this, recoded, m_reloader);
+        endFile();
+
+        ItemParser::Items().swap(m_items);
+        updateMenu();
+    }
+
+private:
+    ItemParser::Items m_items;
+    string m_encoding; ///< encoding for included files
+    AutoReloadHelper *m_reloader;
+    bool m_populated;
+};
+
 void translateMenuItem(FbTk::Parser &parse, ParseItem &pitem,
                        FbTk::StringConvertor &labelconvertor,
                        AutoReloadHelper *reloader) {
@@ -352,17 +450,17 @@ void translateMenuItem(FbTk::Parser &parse, ParseItem &pitem,
     } // end of include
     else if (str_key == "submenu") {
 
-        FbTk::Menu *submenu = MenuCreator::createMenu("", screen_number);
-        if (submenu == 0)
+        BScreen *screen = Fluxbox::instance()->findScreen(screen_number);
+        if (screen == 0)
             return;
 
+        LazyMenu *submenu = new LazyMenu(*screen, reloader);
         if (!str_cmd.empty())
             submenu->setLabel(str_cmd);
         else
             submenu->setLabel(str_label);
 
-        parseMenu(parse, *submenu, labelconvertor, reloader);
-        submenu->updateMenu();
+        submenu->record(parse, labelconvertor);
         menu.insert(str_label, submenu);
 
     } // end of submenu
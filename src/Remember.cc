@@ -22,7 +22,9 @@
 // DEALINGS IN THE SOFTWARE.
 
 #include "Remember.hh"
+#include "RememberApp.hh"
 #include "ClientPattern.hh"
+#include "FocusableProperties.hh"
 #include "Screen.hh"
 #include "Window.hh"
 #include "WinClient.hh"
@@ -40,6 +42,7 @@
 #include "FbTk/stringstream.hh"
 #include "FbTk/Transparent.hh"
 #include "FbTk/AutoReloadHelper.hh"
+#include "FbTk/Tokenizer.hh"
 #include "FbTk/RefCount.hh"
 #include "FbTk/Util.hh"
 
@@ -64,171 +67,12 @@ using std::string;
 using std::list;
 using std::set;
 using std::make_pair;
-using std::ifstream;
-using std::ofstream;
 using std::hex;
 using std::dec;
 
 /*------------------------------------------------------------------*\
 \*------------------------------------------------------------------*/
 
-class Application {
-public:
-    Application(bool transient, bool grouped, ClientPattern *pat = 0);
-    void reset();
-    void forgetWorkspace() { workspace_remember = false; }
-    void forgetHead() { head_remember = false; }
-    void forgetDimensions() { dimensions_remember = false; }
-    void forgetPosition() { position_remember = false; }
-    void forgetShadedstate() { shadedstate_remember = false; }
-    void forgetTabstate() { tabstate_remember = false; }
-    void forgetDecostate() { decostate_remember = false; }
-    void forgetFocusHiddenstate() { focushiddenstate_remember= false; }
-    void forgetIconHiddenstate() { iconhiddenstate_remember= false; }
-    void forgetStuckstate() { stuckstate_remember = false; }
-    void forgetFocusNewWindow() { focusnewwindow_remember = false; }
-    void forgetJumpworkspace() { jumpworkspace_remember = false; }
-    void forgetLayer() { layer_remember = false; }
-    void forgetSaveOnClose() { save_on_close_remember = false; }
-    void forgetAlpha() { alpha_remember = false; }
-    void forgetMinimizedstate() { minimizedstate_remember = false; }
-    void forgetMaximizedstate() { maximizedstate_remember = false; }
-    void forgetFullscreenstate() { fullscreenstate_remember = false; }
-
-    void rememberWorkspace(int ws)
-        { workspace = ws; workspace_remember = true; }
-    void rememberHead(int h)
-        { head = h; head_remember = true; }
-    void rememberDimensions(int width, int height)
-        { w = width; h = height; dimensions_remember = true; }
-    void rememberFocusHiddenstate(bool state)
-        { focushiddenstate= state; focushiddenstate_remember= true; }
-    void rememberIconHiddenstate(bool state)
-        { iconhiddenstate= state; iconhiddenstate_remember= true; }
-    void rememberPosition(int posx, int posy,
-                 FluxboxWindow::ReferenceCorner rfc = FluxboxWindow::LEFTTOP)
-        { x = posx; y = posy; refc = rfc; position_remember = true; }
-    void rememberShadedstate(bool state)
-        { shadedstate = state; shadedstate_remember = true; }
-    void rememberTabstate(bool state)
-        { tabstate = state; tabstate_remember = true; }
-    void rememberDecostate(unsigned int state)
-        { decostate = state; decostate_remember = true; }
-    void rememberStuckstate(bool state)
-        { stuckstate = state; stuckstate_remember = true; }
-    void rememberFocusNewWindow(bool state)
-        { focusnewwindow = state; focusnewwindow_remember = true; }
-    void rememberJumpworkspace(bool state)
-        { jumpworkspace = state; jumpworkspace_remember = true; }
-    void rememberLayer(int layernum) 
-        { layer = layernum; layer_remember = true; }
-    void rememberSaveOnClose(bool state)
-        { save_on_close = state; save_on_close_remember = true; }
-    void rememberAlpha(int focused_a, int unfocused_a)
-        { focused_alpha = focused_a; unfocused_alpha = unfocused_a; alpha_remember = true; }
-    void rememberMinimizedstate(bool state)
-        { minimizedstate = state; minimizedstate_remember = true; }
-    void rememberMaximizedstate(int state)
-        { maximizedstate = state; maximizedstate_remember = true; }
-    void rememberFullscreenstate(bool state)
-        { fullscreenstate = state; fullscreenstate_remember = true; }
-
-    bool workspace_remember;
-    unsigned int workspace;
-
-    bool head_remember;
-    int head;
-
-    bool dimensions_remember;
-    int w,h; // width, height
-
-    bool position_remember;
-    int x,y;
-    FluxboxWindow::ReferenceCorner refc;
-
-    bool alpha_remember;
-    int focused_alpha;
-    int unfocused_alpha;
-
-    bool shadedstate_remember;
-    bool shadedstate;
-
-    bool tabstate_remember;
-    bool tabstate;
-
-    bool decostate_remember;
-    unsigned int decostate;
-
-    bool stuckstate_remember;
-    bool stuckstate;
-
-    bool focusnewwindow_remember;
-    bool focusnewwindow;
-
-    bool focushiddenstate_remember;
-    bool focushiddenstate;
-
-    bool iconhiddenstate_remember;
-    bool iconhiddenstate;
-
-    bool jumpworkspace_remember;
-    bool jumpworkspace;
-
-    bool layer_remember;
-    int layer;
-
-    bool save_on_close_remember;
-    bool save_on_close;
-
-    bool minimizedstate_remember;
-    bool minimizedstate;
-
-    bool maximizedstate_remember;
-    int maximizedstate;
-
-    bool fullscreenstate_remember;
-    bool fullscreenstate;
-
-    bool is_transient, is_grouped;
-    FbTk::RefCount<ClientPattern> group_pattern;
-
-};
-
-
-
-
-
-
-Application::Application(bool transient, bool grouped, ClientPattern *pat):
-    is_transient(transient), is_grouped(grouped), group_pattern(pat)
-{
-    reset();
-}
-
-void Application::reset() {
-    decostate_remember =
-        dimensions_remember =
-        focushiddenstate_remember =
-        iconhiddenstate_remember =
-        jumpworkspace_remember =
-        layer_remember  =
-        position_remember =
-        shadedstate_remember =
-        stuckstate_remember =
-        focusnewwindow_remember =
-        tabstate_remember =
-        workspace_remember =
-        head_remember =
-        alpha_remember =
-        minimizedstate_remember =
-        maximizedstate_remember =
-        fullscreenstate_remember =
-        save_on_close_remember = false;
-}
-
-/*------------------------------------------------------------------*\
-\*------------------------------------------------------------------*/
-
 namespace {
 
 // replace special chars like ( ) and [ ] with \( \) and \[ \]
@@ -413,161 +257,6 @@ bool handleStartupItem(const string &line, int offset) {
 
 
 
-// returns number of lines read
-// optionally can give a line to read before the first (lookahead line)
-int parseApp(ifstream &file, Application &app, string *first_line = 0) {
-    string line;
-    _FB_USES_NLS;
-    int row = 0;
-    while (! file.eof()) {
-        if (first_line || getline(file, line)) {
-            if (first_line) {
-                line = *first_line;
-                first_line = 0;
-            }
-
-            row++;
-            FbTk::StringUtil::removeFirstWhitespace(line);
-            FbTk::StringUtil::removeTrailingWhitespace(line);
-            if (line.size() == 0 || line[0] == '#')
-                continue;  //the line is commented or blank
-
-            int parse_pos = 0, err = 0;
-            string str_key, str_option, str_label;
-
-            err = FbTk::StringUtil::getStringBetween(str_key,
-                                                     line.c_str(),
-                                                     '[', ']');
-            if (err > 0) {
-                int tmp;
-                tmp= FbTk::StringUtil::getStringBetween(str_option,
-                                                        line.c_str() + err,
-                                                        '(', ')');
-                if (tmp>0)
-                    err += tmp;
-            }
-            if (err > 0 ) {
-                parse_pos += err;
-                err = FbTk::StringUtil::getStringBetween(str_label,
-                                                         line.c_str() + parse_pos,
-                                                         '{', '}');
-                if (err>0) {
-                    parse_pos += err;
-                }
-            } else
-                continue; //read next line
-
-            bool had_error = false;
-
-            if (str_key.empty())
-                continue; //read next line
-
-            str_key = FbTk::StringUtil::toLower(str_key);
-
-            if (str_key == "workspace") {
-                unsigned int w;
-                if (FbTk::StringUtil::extractNumber(str_label, w))
-                    app.rememberWorkspace(w);
-                else
-                    had_error = true;
-            } else if (str_key == "head") {
-                unsigned int h;
-                if (FbTk::StringUtil::extractNumber(str_label, h))
-                    app.rememberHead(h);
-                else
-                    had_error = true;
-            } else if (str_key == "layer") {
-                int l = ResourceLayer::getNumFromString(str_label);
-                had_error = (l == -1);
-                if (!had_error)
-                    app.rememberLayer(l);
-            } else if (str_key == "dimensions") {
-                unsigned int h,w;
-                if (sscanf(str_label.c_str(), "%u %u", &w, &h) == 2)
-                    app.rememberDimensions(w, h);
-                else
-                    had_error = true;
-            } else if (str_key == "position") {
-                FluxboxWindow::ReferenceCorner r = FluxboxWindow::LEFTTOP;
-                int x = 0, y = 0;
-                // more info about the parameter
-                // in ::rememberPosition
-
-                if (str_option.length())
-                    r = FluxboxWindow::getCorner(str_option);
-                had_error = (r == FluxboxWindow::ERROR);
-
-                if (!had_error && sscanf(str_label.c_str(), "%d %d", &x, &y) == 2)
-                    app.rememberPosition(x, y, r);
-                else
-                    had_error = true;
-            } else if (str_key == "shaded") {
-                app.rememberShadedstate((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "tab") {
-                app.rememberTabstate((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "focushidden") {
-                app.rememberFocusHiddenstate((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "iconhidden") {
-                app.rememberIconHiddenstate((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "hidden") {
-                app.rememberIconHiddenstate((strcasecmp(str_label.c_str(), "yes") == 0));
-                app.rememberFocusHiddenstate((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "deco") {
-                int deco = WindowState::getDecoMaskFromString(str_label);
-                if (deco == -1)
-                    had_error = 1;
-                else
-                    app.rememberDecostate((unsigned int)deco);
-            } else if (str_key == "alpha") {
-                int focused_a, unfocused_a;
-                switch (sscanf(str_label.c_str(), "%i %i", &focused_a, &unfocused_a)) {
-                case 1: // 'alpha <focus>'
-                    unfocused_a = focused_a;
-                case 2: // 'alpha <focus> <unfocus>'
-                    focused_a = FbTk::Util::clamp(focused_a, 0, 255);
-                    unfocused_a = FbTk::Util::clamp(unfocused_a, 0, 255);
-                    app.rememberAlpha(focused_a, unfocused_a);
-                    break;
-                default:
-                    had_error = true;
-                    break;
-                }
-            } else if (str_key == "sticky") {
-                app.rememberStuckstate((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "focusnewwindow") {
-                app.rememberFocusNewWindow((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "minimized") {
-                app.rememberMinimizedstate((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "maximized") {
-                if (strcasecmp(str_label.c_str(), "yes") == 0)
-                    app.rememberMaximizedstate(WindowState::MAX_FULL);
-                else if (strcasecmp(str_label.c_str(), "horz") == 0)
-                    app.rememberMaximizedstate(WindowState::MAX_HORZ);
-                else if (strcasecmp(str_label.c_str(), "vert") == 0)
-                    app.rememberMaximizedstate(WindowState::MAX_VERT);
-                else
-                    app.rememberMaximizedstate(WindowState::MAX_NONE);
-            } else if (str_key == "fullscreen") {
-                app.rememberFullscreenstate((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "jump") {
-                app.rememberJumpworkspace((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "close") {
-                app.rememberSaveOnClose((strcasecmp(str_label.c_str(), "yes") == 0));
-            } else if (str_key == "end") {
-                return row;
-            } else {
-                cerr << _FB_CONSOLETEXT(Remember, Unknown, "Unknown apps key", "apps entry type not known")<<" = " << str_key << endl;
-            }
-            if (had_error) {
-                cerr<<"Error parsing apps entry: ("<<line<<")"<<endl;
-            }
-        }
-    }
-    return row;
-}
-
-
-
 /*
   This function is used to search for old instances of the same pattern
   (when reloading apps file). More than one pattern might match, but only
@@ -624,6 +313,7 @@ Remember *Remember::s_instance = 0;
 
 Remember::Remember():
     m_pats(new Patterns()),
+    m_index_valid(false),
     m_reloader(new FbTk::AutoReloadHelper()) {
 
     setName("remember");
@@ -635,11 +325,22 @@ Remember::Remember():
     enableUpdate();
 
     m_reloader->setReloadCmd(FbTk::RefCount<FbTk::Command<void> >(new FbTk::SimpleCommand<Remember>(*this, &Remember::reload)));
+
+    m_save_timer.setTimeout(1, 0);
+    m_save_timer.setCommand(FbTk::RefCount<FbTk::Command<void> >(new FbTk::SimpleCommand<Remember>(*this, &Remember::write)));
+    m_save_timer.fireOnce(true);
+
     reconfigure();
 }
 
 Remember::~Remember() {
 
+    // flush a pending save()
+    if (m_save_timer.isTiming()) {
+        m_save_timer.stop();
+        write();
+    }
+
     // free our resources
 
     // the patterns free the "Application"s
@@ -665,24 +366,78 @@ Remember::~Remember() {
 
 Application* Remember::find(WinClient &winclient) {
     // if it is already associated with a application, return that one
-    // otherwise, check it against every pattern that we've got
+    // otherwise, check it against every pattern that could match it
     Clients::iterator wc_it = m_clients.find(&winclient);
     if (wc_it != m_clients.end())
         return wc_it->second;
-    else {
-        Patterns::iterator it = m_pats->begin();
-        for (; it != m_pats->end(); it++)
-            if (it->first->match(winclient) &&
-                it->second->is_transient == winclient.isTransient()) {
-                it->first->addMatch();
-                m_clients[&winclient] = it->second;
-                return it->second;
-            }
+
+    if (!m_index_valid)
+        buildIndex();
+
+    // all patterns look at the same properties of the window
+    FocusableProperties props(winclient);
+
+    static const Positions none;
+    PatternIndex::const_iterator name_it =
+        m_name_index.find(props.text(ClientPattern::NAME));
+    PatternIndex::const_iterator class_it =
+        m_class_index.find(props.text(ClientPattern::CLASS));
+    const Positions &by_name = (name_it != m_name_index.end() ? name_it->second : none);
+    const Positions &by_class = (class_it != m_class_index.end() ? class_it->second : none);
+
+    // walk the candidates in apps file order, the first match wins
+    size_t n = 0, c = 0, u = 0;
+    const size_t end = m_index_pats.size();
+    while (true) {
+        size_t pos = end;
+        if (n < by_name.size())
+            pos = by_name[n];
+        if (c < by_class.size() && by_class[c] < pos)
+            pos = by_class[c];
+        if (u < m_unindexed.size() && m_unindexed[u] < pos)
+            pos = m_unindexed[u];
+        if (pos == end)
+            break;
+
+        if (n < by_name.size() && by_name[n] == pos)
+            ++n;
+        else if (c < by_class.size() && by_class[c] == pos)
+            ++c;
+        else
+            ++u;
+
+        Patterns::iterator it = m_index_pats[pos];
+        if (it->first->match(props) &&
+            it->second->is_transient == winclient.isTransient()) {
+            it->first->addMatch();
+            m_clients[&winclient] = it->second;
+            return it->second;
+        }
     }
     // oh well, no matches
     return 0;
 }
 
+void Remember::buildIndex() {
+    m_index_pats.clear();
+    m_name_index.clear();
+    m_class_index.clear();
+    m_unindexed.clear();
+
+    FbTk::FbString value;
+    Patterns::iterator it = m_pats->begin(), it_end = m_pats->end();
+    for (size_t pos = 0; it != it_end; ++it, ++pos) {
+        m_index_pats.push_back(it);
+        if (it->first->literalTerm(ClientPattern::NAME, value))
+            m_name_index[value].push_back(pos);
+        else if (it->first->literalTerm(ClientPattern::CLASS, value))
+            m_class_index[value].push_back(pos);
+        else
+            m_unindexed.push_back(pos);
+    }
+    m_index_valid = true;
+}
+
 Application * Remember::add(WinClient &winclient) {
     ClientPattern *p = new ClientPattern();
     Application *app = new Application(winclient.isTransient(), false);
@@ -699,6 +454,7 @@ Application * Remember::add(WinClient &winclient) {
     m_clients[&winclient] = app;
     p->addMatch();
     m_pats->push_back(make_pair(p, app));
+    invalidateIndex();
     return app;
 }
 
@@ -714,45 +470,48 @@ void Remember::checkReload() {
 }
 
 void Remember::reload() {
+    // or the file would undo changes that aren't saved yet
+    if (m_save_timer.isTiming()) {
+        m_save_timer.stop();
+        write();
+    }
+
     string apps_string = FbTk::StringUtil::expandFilename(Fluxbox::instance()->getAppsFilename());
 
 
     fbdbg<<"("<<__FUNCTION__<<"): Loading apps file ["<<apps_string<<"]"<<endl;
 
-    ifstream apps_file(apps_string.c_str());
+    FbTk::Tokenizer apps_file;
 
     // we merge the old patterns with new ones
     Patterns *old_pats = m_pats.release();
     set<Application *> reused_apps;
     m_pats.reset(new Patterns());
+    invalidateIndex();
     m_startups.clear();
 
-    if (!apps_file.fail()) {
+    if (apps_file.open(apps_string)) {
         if (!apps_file.eof()) {
-            string line;
-            int row = 0;
             bool in_group = false;
             ClientPattern *pat = 0;
             list<ClientPattern *> grouped_pats;
-            while (getline(apps_file, line) && ! apps_file.eof()) {
-                row++;
-                FbTk::StringUtil::removeFirstWhitespace(line);
-                FbTk::StringUtil::removeTrailingWhitespace(line);
-                if (line.size() == 0 || line[0] == '#')
+            while (apps_file.nextLine()) {
+                FbTk::Token line = apps_file.line().trimmed();
+                if (line.empty() || line[0] == '#')
                     continue;
-                string key;
+                FbTk::Token key;
                 int err=0;
-                int pos = FbTk::StringUtil::getStringBetween(key,
-                                                             line.c_str(),
-                                                             '[', ']');
-
-                if (pos > 0 && (strcasecmp(key.c_str(), "app") == 0 ||
-                                strcasecmp(key.c_str(), "transient") == 0)) {
-                    ClientPattern *pat = new ClientPattern(line.c_str() + pos);
+                int pos = 0;
+                if (apps_file.between('[', ']', key))
+                    pos = apps_file.rest().begin() - line.begin();
+                // whatever follows the key
+                FbTk::Token rest(line.begin() + pos, line.end());
+
+                if (pos > 0 && (key.iequals("app") || key.iequals("transient"))) {
+                    ClientPattern *pat = new ClientPattern(rest.str().c_str());
                     if (!in_group) {
                         if ((err = pat->error()) == 0) {
-                            bool transient = (strcasecmp(key.c_str(),
-                                                         "transient") == 0);
+                            bool transient = key.iequals("transient");
                             Application *app = findMatchingPatterns(pat,
                                                    old_pats, transient, false);
                             if (app) {
@@ -763,25 +522,25 @@ void Remember::reload() {
                             }
 
                             m_pats->push_back(make_pair(pat, app));
-                            row += parseApp(apps_file, *app);
+                            parseApp(apps_file, *app);
                         } else {
-                            cerr<<"Error reading apps file at line "<<row<<", column "<<(err+pos)<<"."<<endl;
+                            cerr<<"Error reading apps file at line "<<apps_file.row()<<", column "<<(err+pos)<<"."<<endl;
                             delete pat; // since it didn't work
                         }
                     } else {
                         grouped_pats.push_back(pat);
                     }
-                } else if (pos > 0 && strcasecmp(key.c_str(), "startup") == 0 &&
+                } else if (pos > 0 && key.iequals("startup") &&
                            Fluxbox::instance()->isStartup()) {
-                    if (!handleStartupItem(line, pos)) {
-                        cerr<<"Error reading apps file at line "<<row<<"."<<endl;
+                    if (!handleStartupItem(line.str(), pos)) {
+                        cerr<<"Error reading apps file at line "<<apps_file.row()<<"."<<endl;
                     }
                     // save the item even if it was bad (aren't we nice)
-                    m_startups.push_back(line.substr(pos));
-                } else if (pos > 0 && strcasecmp(key.c_str(), "group") == 0) {
+                    m_startups.push_back(rest.str());
+                } else if (pos > 0 && key.iequals("group")) {
                     in_group = true;
-                    if (line.find('(') != string::npos)
-                        pat = new ClientPattern(line.c_str() + pos);
+                    if (memchr(line.begin(), '(', line.size()))
+                        pat = new ClientPattern(rest.str().c_str());
                 } else if (in_group) {
                     // otherwise assume that it is the start of the attributes
                     Application *app = 0;
@@ -808,12 +567,12 @@ void Remember::reload() {
                     // we hit end... probably don't have attribs for the group
                     // so finish it off with an empty application
                     // otherwise parse the app
-                    if (!(pos>0 && strcasecmp(key.c_str(), "end") == 0)) {
-                        row += parseApp(apps_file, *app, &line);
+                    if (!(pos>0 && key.iequals("end"))) {
+                        parseApp(apps_file, *app, true);
                     }
                     in_group = false;
                 } else
-                    cerr<<"Error in apps file on line "<<row<<"."<<endl;
+                    cerr<<"Error in apps file on line "<<apps_file.row()<<"."<<endl;
 
             }
         } else {
@@ -859,12 +618,18 @@ void Remember::reload() {
 }
 
 void Remember::save() {
+    // toggling remember items and closing windows come in bursts
+    if (!m_save_timer.isTiming())
+        m_save_timer.start();
+}
+
+void Remember::write() {
 
     string apps_string = FbTk::StringUtil::expandFilename(Fluxbox::instance()->getAppsFilename());
 
     fbdbg<<"("<<__FUNCTION__<<"): Saving apps file ["<<apps_string<<"]"<<endl;
 
-    ofstream apps_file(apps_string.c_str());
+    FbTk_ostringstream apps_file;
 
     // first of all we output all the startup commands
     Startups::iterator sit = m_startups.begin();
@@ -876,29 +641,34 @@ void Remember::save() {
     Patterns::iterator it = m_pats->begin();
     Patterns::iterator it_end = m_pats->end();
 
-    set<Application *> grouped_apps; // no duplicates
-
+    // collect the members of each group in one pass
+    typedef std::map<Application *, list<ClientPattern *> > Groups;
+    Groups groups;
     for (; it != it_end; ++it) {
+        if (it->second->is_grouped)
+            groups[it->second].push_back(it->first);
+    }
+
+    for (it = m_pats->begin(); it != it_end; ++it) {
         Application &a = *it->second;
         if (a.is_grouped) {
             // if already processed
-            if (grouped_apps.find(&a) != grouped_apps.end())
+            Groups::iterator group = groups.find(&a);
+            if (group == groups.end())
                 continue;
-            grouped_apps.insert(&a);
             // otherwise output this whole group
             apps_file << "[group]";
             if (a.group_pattern)
                 apps_file << " " << a.group_pattern->toString();
             apps_file << endl;
 
-            Patterns::iterator git = m_pats->begin();
-            Patterns::iterator git_end = m_pats->end();
+            list<ClientPattern *>::iterator git = group->second.begin();
+            list<ClientPattern *>::iterator git_end = group->second.end();
             for (; git != git_end; git++) {
-                if (git->second == &a) {
-                    apps_file << (a.is_transient ? " [transient]" : " [app]") <<
-                                 git->first->toString()<<endl;
-                }
+                apps_file << (a.is_transient ? " [transient]" : " [app]") <<
+                             (*git)->toString()<<endl;
             }
+            groups.erase(group);
         } else {
             apps_file << (a.is_transient ? "[transient]" : "[app]") <<
                          it->first->toString()<<endl;
@@ -1034,7 +804,9 @@ void Remember::save() {
         }
         apps_file << "[end]" << endl;
     }
-    apps_file.close();
+
+    // the file is replaced in one go, a crash never leaves half of it
+    FbTk::FileUtil::writeFile(apps_string.c_str(), apps_file.str());
     // update timestamp to avoid unnecessary reload
     m_reloader->addFile(Fluxbox::instance()->getAppsFilename());
 }
@@ -28,10 +28,11 @@
 
 #include "AtomHandler.hh"
 #include "ClientPattern.hh"
-
+#include "FbTk/Timer.hh"
 
 #include <map>
 #include <list>
+#include <vector>
 #include <memory>
 
 class FluxboxWindow;
@@ -152,13 +153,31 @@ public:
 
 private:
 
+    /// find() has to rebuild its index after m_pats changed
+    void invalidateIndex() { m_index_valid = false; }
+    void buildIndex();
+
+    /// writes the apps file now, save() only schedules this
+    void write();
+
     std::auto_ptr<Patterns> m_pats;
     Clients m_clients;
 
+    // Most patterns require a literal WM_CLASS name or class, they are
+    // only worth matching against windows with that name/class.
+    // Entries are positions in m_pats, in ascending order.
+    typedef std::vector<size_t> Positions;
+    typedef std::map<FbTk::FbString, Positions> PatternIndex;
+    std::vector<Patterns::iterator> m_index_pats; ///< m_pats by position
+    PatternIndex m_name_index, m_class_index;
+    Positions m_unindexed; ///< patterns without such a term
+    bool m_index_valid;
+
     Startups m_startups;
     static Remember *s_instance;
 
     FbTk::AutoReloadHelper* m_reloader;
+    FbTk::Timer m_save_timer; ///< coalesces save() requests into one write
 };
 
 #endif // REMEMBER_HH
@@ -0,0 +1,206 @@
+// RememberApp.cc for fluxbox
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "RememberApp.hh"
+#include "ClientPattern.hh"
+#include "WindowState.hh"
+#include "Layer.hh"
+
+#include "FbTk/I18n.hh"
+#include "FbTk/StringUtil.hh"
+#include "FbTk/Tokenizer.hh"
+#include "FbTk/Util.hh"
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#ifdef HAVE_CSTDIO
+  #include <cstdio>
+#else
+  #include <stdio.h>
+#endif
+#ifdef HAVE_CSTRING
+  #include <cstring>
+#else
+  #include <string.h>
+#endif
+
+#include <iostream>
+
+using std::cerr;
+using std::endl;
+using std::string;
+
+Application::Application(bool transient, bool grouped, ClientPattern *pat):
+    is_transient(transient), is_grouped(grouped), group_pattern(pat)
+{
+    reset();
+}
+
+void Application::reset() {
+    decostate_remember =
+        dimensions_remember =
+        focushiddenstate_remember =
+        iconhiddenstate_remember =
+        jumpworkspace_remember =
+        layer_remember  =
+        position_remember =
+        shadedstate_remember =
+        stuckstate_remember =
+        focusnewwindow_remember =
+        tabstate_remember =
+        workspace_remember =
+        head_remember =
+        alpha_remember =
+        minimizedstate_remember =
+        maximizedstate_remember =
+        fullscreenstate_remember =
+        save_on_close_remember = false;
+}
+
+void parseApp(FbTk::Tokenizer &file, Application &app, bool use_current_line) {
+    _FB_USES_NLS;
+    // reused for every line
+    string str_option, str_label;
+    while (use_current_line || file.nextLine()) {
+        if (use_current_line) {
+            file.resetLine();
+            use_current_line = false;
+        }
+
+        FbTk::Token line = file.line().trimmed();
+        if (line.empty() || line[0] == '#')
+            continue;  //the line is commented or blank
+
+        FbTk::Token str_key, option, label;
+        if (!file.between('[', ']', str_key))
+            continue; //read next line
+        file.between('(', ')', option);
+        file.between('{', '}', label);
+
+        if (str_key.empty())
+            continue; //read next line
+
+        option.assignTo(str_option);
+        label.assignTo(str_label);
+
+        bool had_error = false;
+
+        if (str_key.iequals("workspace")) {
+            unsigned int w;
+            if (FbTk::StringUtil::extractNumber(str_label, w))
+                app.rememberWorkspace(w);
+            else
+                had_error = true;
+        } else if (str_key.iequals("head")) {
+            unsigned int h;
+            if (FbTk::StringUtil::extractNumber(str_label, h))
+                app.rememberHead(h);
+            else
+                had_error = true;
+        } else if (str_key.iequals("layer")) {
+            int l = ResourceLayer::getNumFromString(str_label);
+            had_error = (l == -1);
+            if (!had_error)
+                app.rememberLayer(l);
+        } else if (str_key.iequals("dimensions")) {
+            unsigned int h,w;
+            if (sscanf(str_label.c_str(), "%u %u", &w, &h) == 2)
+                app.rememberDimensions(w, h);
+            else
+                had_error = true;
+        } else if (str_key.iequals("position")) {
+            FluxboxWindow::ReferenceCorner r = FluxboxWindow::LEFTTOP;
+            int x = 0, y = 0;
+            // more info about the parameter
+            // in ::rememberPosition
+
+            if (str_option.length())
+                r = FluxboxWindow::getCorner(str_option);
+            had_error = (r == FluxboxWindow::ERROR);
+
+            if (!had_error && sscanf(str_label.c_str(), "%d %d", &x, &y) == 2)
+                app.rememberPosition(x, y, r);
+            else
+                had_error = true;
+        } else if (str_key.iequals("shaded")) {
+            app.rememberShadedstate((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("tab")) {
+            app.rememberTabstate((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("focushidden")) {
+            app.rememberFocusHiddenstate((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("iconhidden")) {
+            app.rememberIconHiddenstate((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("hidden")) {
+            app.rememberIconHiddenstate((strcasecmp(str_label.c_str(), "yes") == 0));
+            app.rememberFocusHiddenstate((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("deco")) {
+            int deco = WindowState::getDecoMaskFromString(str_label);
+            if (deco == -1)
+                had_error = 1;
+            else
+                app.rememberDecostate((unsigned int)deco);
+        } else if (str_key.iequals("alpha")) {
+            int focused_a, unfocused_a;
+            switch (sscanf(str_label.c_str(), "%i %i", &focused_a, &unfocused_a)) {
+            case 1: // 'alpha <focus>'
+                unfocused_a = focused_a;
+            case 2: // 'alpha <focus> <unfocus>'
+                focused_a = FbTk::Util::clamp(focused_a, 0, 255);
+                unfocused_a = FbTk::Util::clamp(unfocused_a, 0, 255);
+                app.rememberAlpha(focused_a, unfocused_a);
+                break;
+            default:
+                had_error = true;
+                break;
+            }
+        } else if (str_key.iequals("sticky")) {
+            app.rememberStuckstate((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("focusnewwindow")) {
+            app.rememberFocusNewWindow((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("minimized")) {
+            app.rememberMinimizedstate((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("maximized")) {
+            if (strcasecmp(str_label.c_str(), "yes") == 0)
+                app.rememberMaximizedstate(WindowState::MAX_FULL);
+            else if (strcasecmp(str_label.c_str(), "horz") == 0)
+                app.rememberMaximizedstate(WindowState::MAX_HORZ);
+            else if (strcasecmp(str_label.c_str(), "vert") == 0)
+                app.rememberMaximizedstate(WindowState::MAX_VERT);
+            else
+                app.rememberMaximizedstate(WindowState::MAX_NONE);
+        } else if (str_key.iequals("fullscreen")) {
+            app.rememberFullscreenstate((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("jump")) {
+            app.rememberJumpworkspace((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("close")) {
+            app.rememberSaveOnClose((strcasecmp(str_label.c_str(), "yes") == 0));
+        } else if (str_key.iequals("end")) {
+            return;
+        } else {
+            cerr << _FB_CONSOLETEXT(Remember, Unknown, "Unknown apps key", "apps entry type not known")<<" = " << FbTk::StringUtil::toLower(str_key.str()) << endl;
+        }
+        if (had_error) {
+            cerr<<"Error parsing apps entry: ("<<line.str()<<")"<<endl;
+        }
+    }
+}
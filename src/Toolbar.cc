@@ -422,6 +422,7 @@ void Toolbar::reconfigure() {
                 if (item == 0)
                     continue;
                 m_item_list.push_back(item);
+                item->parentHidden(isHidden() || !*m_rc_visible);
                 m_signal_tracker.join(item->resizeSig(),
                         FbTk::MemFun(*this, &Toolbar::rearrangeItems));
             }
@@ -752,6 +753,8 @@ void Toolbar::setPlacement(Toolbar::Placement where) {
 
 void Toolbar::updateVisibleState() {
     *m_rc_visible ? frame.window.show() : frame.window.hide();
+    forAll(m_item_list, std::bind2nd(std::mem_fun(&ToolbarItem::parentHidden),
+                                     isHidden() || !*m_rc_visible));
 }
 
 void Toolbar::toggleHidden() {
@@ -764,6 +767,8 @@ void Toolbar::toggleHidden() {
         frame.window.move(frame.x, frame.y);
         forAll(m_item_list, std::mem_fun(&ToolbarItem::parentMoved));
     }
+    forAll(m_item_list, std::bind2nd(std::mem_fun(&ToolbarItem::parentHidden),
+                                     isHidden() || !*m_rc_visible));
 
 }
 
@@ -58,6 +58,8 @@ public:
 
     // insist implemented, even if blank
     virtual void parentMoved() = 0; // called when moved from hiding
+    /// called when the toolbar is (auto)hidden or shown again
+    virtual void parentHidden(bool hidden) { }
 
     // just update theme items that affect the size
     virtual void updateSizing() = 0;
@@ -3691,29 +3691,6 @@ void FluxboxWindow::associateClient(WinClient &client) {
          FbTk::MemFun(*this, &FluxboxWindow::setTitle));
 }
 
-FluxboxWindow::ReferenceCorner FluxboxWindow::getCorner(string str) {
-    str = FbTk::StringUtil::toLower(str);
-    if (str == "lefttop" || str == "topleft" || str == "upperleft" || str == "")
-        return LEFTTOP;
-    if (str == "top" || str == "upper" || str == "topcenter")
-        return TOP;
-    if (str == "righttop" || str == "topright" || str == "upperright")
-        return RIGHTTOP;
-    if (str == "left" || str == "leftcenter")
-        return LEFT;
-    if (str == "center" || str == "wincenter")
-        return CENTER;
-    if (str == "right" || str == "rightcenter")
-        return RIGHT;
-    if (str == "leftbottom" || str == "bottomleft" || str == "lowerleft")
-        return LEFTBOTTOM;
-    if (str == "bottom" || str == "lower" || str == "bottomcenter")
-        return BOTTOM;
-    if (str == "rightbottom" || str == "bottomright" || str == "lowerright")
-        return RIGHTBOTTOM;
-    return ERROR;
-}
-
 void FluxboxWindow::translateCoords(int &x, int &y, ReferenceCorner dir) const {
     int head = getOnHead(), bw = 2 * frame().window().borderWidth(),
         left = screen().maxLeft(head), right = screen().maxRight(head),
@@ -20,6 +20,7 @@
 // DEALINGS IN THE SOFTWARE.
 
 #include "WindowState.hh"
+#include "Window.hh"
 
 #include "FbTk/StringUtil.hh"
 
@@ -109,6 +110,30 @@ int WindowState::getDecoMaskFromString(const std::string &str_label) {
     return mask;
 }
 
+// lives here so the apps file parser links without the rest of Window.cc
+FluxboxWindow::ReferenceCorner FluxboxWindow::getCorner(std::string str) {
+    str = FbTk::StringUtil::toLower(str);
+    if (str == "lefttop" || str == "topleft" || str == "upperleft" || str == "")
+        return LEFTTOP;
+    if (str == "top" || str == "upper" || str == "topcenter")
+        return TOP;
+    if (str == "righttop" || str == "topright" || str == "upperright")
+        return RIGHTTOP;
+    if (str == "left" || str == "leftcenter")
+        return LEFT;
+    if (str == "center" || str == "wincenter")
+        return CENTER;
+    if (str == "right" || str == "rightcenter")
+        return RIGHT;
+    if (str == "leftbottom" || str == "bottomleft" || str == "lowerleft")
+        return LEFTBOTTOM;
+    if (str == "bottom" || str == "lower" || str == "bottomcenter")
+        return BOTTOM;
+    if (str == "rightbottom" || str == "bottomright" || str == "lowerright")
+        return RIGHTBOTTOM;
+    return ERROR;
+}
+
 bool SizeHints::isResizable() const {
     return max_width == 0 || max_height == 0 ||
            max_width > min_width || max_height > min_height;
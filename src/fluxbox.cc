@@ -305,6 +305,13 @@ Fluxbox::Fluxbox(int argc, char **argv,
     m_reconfig_timer.setCommand(reconfig_cmd);
     m_reconfig_timer.fireOnce(true);
 
+    // clicking through the configuration menus calls save_rc() for every
+    // change, write the file at most once a second
+    FbTk::RefCount<FbTk::Command<void> > save_rc_cmd(new FbTk::SimpleCommand<Fluxbox>(*this, &Fluxbox::write_rc));
+    m_save_rc_timer.setTimeout(1, 0);
+    m_save_rc_timer.setCommand(save_rc_cmd);
+    m_save_rc_timer.fireOnce(true);
+
     if (xsync)
         XSynchronize(disp, True);
 
@@ -343,6 +350,7 @@ Fluxbox::Fluxbox(int argc, char **argv,
 
 
     // setup theme manager to have our style file ready to be scanned
+    FbTk::ThemeManager::instance().setCacheDirectory(getDefaultDataFilename("stylecache"));
     FbTk::ThemeManager::instance().load(getStyleFilename(), getStyleOverlayFilename());
 
     // Create keybindings handler and load keys file
@@ -454,6 +462,8 @@ Fluxbox::Fluxbox(int argc, char **argv,
 
 Fluxbox::~Fluxbox() {
 
+    flush_rc();
+
     // this needs to be destroyed before screens; otherwise, menus stored in
     // key commands cause a segfault when the LayerItem is destroyed
     m_key.reset(0);
@@ -1111,6 +1121,8 @@ void Fluxbox::shutdown() {
 
     m_shutdown = true;
 
+    flush_rc();
+
     XSetInputFocus(FbTk::App::instance()->display(), PointerRoot, None, CurrentTime);
 
     STLUtil::forAll(m_screen_list, mem_fun(&BScreen::shutdown));
@@ -1118,19 +1130,41 @@ void Fluxbox::shutdown() {
     sync(false);
 }
 
-/// saves resources
+/// saves resources, once the current burst of changes is over
 void Fluxbox::save_rc() {
+    // nothing runs the timer anymore
+    if (m_shutdown) {
+        write_rc();
+        return;
+    }
+
+    if (!m_save_rc_timer.isTiming())
+        m_save_rc_timer.start();
+}
+
+void Fluxbox::flush_rc() {
+    if (m_save_rc_timer.isTiming()) {
+        m_save_rc_timer.stop();
+        write_rc();
+    }
+}
+
+void Fluxbox::write_rc() {
     _FB_USES_NLS;
-    XrmDatabase new_rc = 0;
 
     string dbfile(getRcFilename());
 
-    if (!dbfile.empty()) {
-        m_resourcemanager.save(dbfile.c_str(), dbfile.c_str());
-        m_screen_rm.save(dbfile.c_str(), dbfile.c_str());
-    } else
+    if (dbfile.empty()) {
         cerr<<_FB_CONSOLETEXT(Fluxbox, BadRCFile, "rc filename is invalid!", "Bad settings file")<<endl;
+        return;
+    }
+
+    dbfile = FbTk::StringUtil::expandFilename(dbfile);
 
+    // build everything in one database and write it once
+    XrmDatabase new_rc = 0;
+    m_resourcemanager.put(new_rc);
+    m_screen_rm.put(new_rc);
 
     ScreenList::iterator it = m_screen_list.begin();
     ScreenList::iterator it_end = m_screen_list.end();
@@ -1148,7 +1182,7 @@ void Fluxbox::save_rc() {
 
         const BScreen::WorkspaceNames& names = screen->getWorkspaceNames();
         for (size_t i=0; i < names.size(); i++) {
-            workspaces_string += FbTk::FbStringUtil::FbStrToLocale(names[i]);
+            FbTk::FbStringUtil::FbStrToLocale(names[i], workspaces_string);
             workspaces_string += ',';
         }
 
@@ -1156,10 +1190,16 @@ void Fluxbox::save_rc() {
 
     }
 
+    // keep whatever else the user put into the file
     XrmDatabase old_rc = XrmGetFileDatabase(dbfile.c_str());
 
     XrmMergeDatabases(new_rc, &old_rc);
-    XrmPutFileDatabase(old_rc, dbfile.c_str());
+
+    string tmpfile = FbTk::FileUtil::makeTempFile(dbfile.c_str());
+    if (!tmpfile.empty()) {
+        XrmPutFileDatabase(old_rc, tmpfile.c_str());
+        FbTk::FileUtil::replaceFile(tmpfile.c_str(), dbfile.c_str());
+    }
     XrmDestroyDatabase(old_rc);
 
     fbdbg<<__FILE__<<"("<<__LINE__<<"): ------------ SAVING DONE"<<endl;
@@ -1182,6 +1222,9 @@ string Fluxbox::getDefaultDataFilename(const char *name) const {
 void Fluxbox::load_rc() {
     _FB_USES_NLS;
 
+    // or the file would undo changes that aren't saved yet
+    flush_rc();
+
     string dbfile(getRcFilename());
 
     if (!dbfile.empty()) {
@@ -1217,6 +1260,9 @@ void Fluxbox::load_rc() {
 void Fluxbox::load_rc(BScreen &screen) {
     //get resource filename
     _FB_USES_NLS;
+
+    flush_rc();
+
     string dbfile(getRcFilename());
 
     XrmDatabaseHelper database;
@@ -191,6 +191,10 @@ public:
 private:
     std::string getRcFilename();
     void load_rc();
+    /// writes the resource file now, save_rc() only schedules this
+    void write_rc();
+    /// writes the resource file now if a save_rc() is pending
+    void flush_rc();
 
     void real_reconfigure();
 
@@ -281,6 +285,8 @@ private:
 
     ///< when we execute reconfig command we must wait until next event round
     FbTk::Timer m_reconfig_timer;
+    ///< coalesces save_rc() requests into one write
+    FbTk::Timer m_save_rc_timer;
     bool m_showing_dialog;
 
     std::auto_ptr<Keys> m_key;
@@ -20,6 +20,8 @@
 // DEALINGS IN THE SOFTWARE.
 
 #include "FbTk/StringUtil.hh"
+#include "FbTk/FbString.hh"
+#include "benchmark.hh"
 #ifndef _GNU_SOURCE
 #define _GNU_SOURCE
 #endif //_GNU_SOURCE
@@ -126,6 +128,126 @@ void testGetStringBetween() {
         total_pos += pos;
     }
 }
+
+/// converts window titles the way Xutil does, plain ascii and latin-1
+void testRecode() {
+    FbStringUtil::init();
+
+    const string latin1 = "Caf\xe9 - r\xe9sum\xe9.txt";
+    FbString utf8 = FbStringUtil::XStrToFb(latin1);
+    cerr<<"latin-1 to utf-8: "<<
+        (utf8 == "Caf\xc3\xa9 - r\xc3\xa9sum\xc3\xa9.txt" ? "ok" : "FAILED")<<endl;
+    cerr<<"and back:         "<<
+        (FbStringUtil::FbStrToX(utf8) == latin1 ? "ok" : "FAILED")<<endl;
+
+    string long_latin1(10000, '\xe9'); // output twice the input size
+    cerr<<"long string:      "<<
+        (FbStringUtil::XStrToFb(long_latin1).size() == 20000 ? "ok" : "FAILED")<<endl;
+
+    const int count = 200000;
+    const string titles[] = {
+        "xterm - vim src/FbTk/FbString.cc",
+        "Caf\xe9 - r\xe9sum\xe9.txt - Mozilla Firefox"
+    };
+    for (int t = 0; t < 2; ++t) {
+        timeval start;
+        size_t total = 0;
+        gettimeofday(&start, 0);
+        for (int i = 0; i < count; ++i)
+            total += FbStringUtil::XStrToFb(titles[t]).size();
+        double returned = elapsed(start);
+
+        FbString out;
+        gettimeofday(&start, 0);
+        for (int i = 0; i < count; ++i) {
+            out.clear();
+            FbStringUtil::XStrToFb(titles[t], out);
+            total += out.size();
+        }
+        double appended = elapsed(start);
+
+        cerr<<count<<(t == 0 ? " ascii" : " latin-1")<<" titles: "<<
+            returned<<"s returned, "<<appended<<"s appended ("<<total<<" bytes)"<<endl;
+    }
+
+    FbStringUtil::shutdown();
+}
+
+/// formats and parses the numbers ClientPattern and the resources use
+void testNumbers() {
+    const long long numbers[] = { 0, 7, -42, 1234567890, -9223372036854775807LL - 1 };
+    const char *expected[] = { "0", "7", "-42", "1234567890", "-9223372036854775808" };
+    for (int i = 0; i < 5; ++i) {
+        long long back = 1;
+        string str = StringUtil::number2String(numbers[i]);
+        const char *end = StringUtil::chars2Number(str.data(), str.data() + str.size(), back);
+        cerr<<expected[i]<<": "<<(str == expected[i] &&
+                end == str.data() + str.size() && back == numbers[i] ? "ok" : "FAILED")<<endl;
+    }
+
+    const char *rejected[] = { "", "-", "007", "-0", "+1", "9223372036854775808" };
+    for (int i = 0; i < 6; ++i) {
+        long long n;
+        const char *in = rejected[i];
+        cerr<<"\""<<in<<"\" rejected: "<<
+            (StringUtil::chars2Number(in, in + strlen(in), n) == 0 ? "ok" : "FAILED")<<endl;
+    }
+
+    char small[3];
+    cerr<<"too small buffer: "<<
+        (StringUtil::number2Chars(small, small + sizeof(small), 1234) == 0 ? "ok" : "FAILED")<<endl;
+
+    const int count = 1000000;
+    timeval start;
+    size_t total = 0;
+
+    gettimeofday(&start, 0);
+    for (int i = 0; i < count; ++i) {
+        FbTk_ostringstream os;
+        os<<i;
+        total += os.str().size();
+    }
+    double streamed = elapsed(start);
+
+    gettimeofday(&start, 0);
+    for (int i = 0; i < count; ++i)
+        total += StringUtil::number2String(i).size();
+    double returned = elapsed(start);
+
+    string out;
+    gettimeofday(&start, 0);
+    for (int i = 0; i < count; ++i) {
+        out.clear();
+        StringUtil::appendNumber(out, i);
+        total += out.size();
+    }
+    double appended = elapsed(start);
+
+    cerr<<count<<" numbers formatted: "<<streamed<<"s ostringstream, "<<
+        returned<<"s number2String, "<<appended<<"s appendNumber ("<<total<<" bytes)"<<endl;
+
+    const string text = "1234567";
+    long long sum = 0;
+    gettimeofday(&start, 0);
+    for (int i = 0; i < count; ++i) {
+        int n = 0;
+        StringUtil::extractNumber(text, n);
+        sum += n;
+    }
+    double extracted = elapsed(start);
+
+    gettimeofday(&start, 0);
+    for (int i = 0; i < count; ++i) {
+        long long n = 0;
+        StringUtil::chars2Number(text.data(), text.data() + text.size(), n);
+        sum += n;
+    }
+    double parsed = elapsed(start);
+
+    cerr<<count<<" numbers parsed: "<<extracted<<"s extractNumber, "<<
+        parsed<<"s chars2Number ("<<sum<<")"<<endl;
+}
+
 int main() {	
     try {
         string replaceme = "something((((otherthanthis)could[be]changed";
@@ -146,6 +268,10 @@ int main() {
     testExpandFilename();
     cerr<<"Testing strcasestr."<<endl;
     testStrcasestr();
+    cerr<<"Testing recode."<<endl;
+    testRecode();
+    cerr<<"Testing numbers."<<endl;
+    testNumbers();
 
 
     
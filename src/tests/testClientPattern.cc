@@ -0,0 +1,319 @@
+// testClientPattern.cc
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.	IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "ClientPattern.hh"
+#include "FbTk/StringUtil.hh"
+#include "FbTk/RegExp.hh"
+#include "benchmark.hh"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+namespace {
+
+struct TestWindow {
+    string title, name, klass;
+    int workspace;
+};
+
+class WindowProperties: public ClientPattern::Properties {
+public:
+    explicit WindowProperties(const TestWindow &win): m_win(win), fetches(0) { }
+
+    bool current(ClientPattern::WinProperty prop, FbTk::FbString &value) {
+        return false;
+    }
+    int mouseHead() { return 0; }
+    FbTk::FbString xpropText(Atom prop) { return ""; }
+    long xpropCardinal(Atom prop) { return 0; }
+
+protected:
+    FbTk::FbString fetchText(ClientPattern::WinProperty prop) {
+        ++fetches;
+        switch (prop) {
+        case ClientPattern::TITLE:
+            return m_win.title;
+        case ClientPattern::CLASS:
+            return m_win.klass;
+        case ClientPattern::NAME:
+            return m_win.name;
+        default:
+            return "no";
+        }
+    }
+    int fetchNumber(ClientPattern::WinProperty prop) {
+        ++fetches;
+        return prop == ClientPattern::WORKSPACE ? m_win.workspace : 0;
+    }
+
+private:
+    const TestWindow &m_win;
+public:
+    int fetches;
+};
+
+string number(int n) {
+    return FbTk::StringUtil::number2String(n);
+}
+
+#ifdef USE_REGEXP
+/// what RegExp did before it looked at the pattern
+class PlainRegExp {
+public:
+    explicit PlainRegExp(const string &str) {
+        m_ok = regcomp(&m_regex, ("^" + str + "$").c_str(), REG_NOSUB | REG_EXTENDED) == 0;
+    }
+    ~PlainRegExp() {
+        if (m_ok)
+            regfree(&m_regex);
+    }
+    bool match(const string &str) const {
+        return m_ok && regexec(&m_regex, str.c_str(), 0, 0, 0) == 0;
+    }
+private:
+    regex_t m_regex;
+    bool m_ok;
+};
+#endif // USE_REGEXP
+
+} // end anonymous namespace
+
+#ifdef USE_REGEXP
+int test_regexp() {
+
+    printf("testing RegExp against regexec\n");
+
+    const char *patterns[] = {
+        "Firefox", "Fire", "Firefox.*", ".*fox", ".*ref.*", ".*", "",
+        "a\\.b", "a\\.*", "a\\\\.*", ".*.*x", "fire.*fox", "[Ff]irefox",
+        "a\\(b\\)", "x|y", "\\"
+    };
+    const char *strings[] = {
+        "Firefox", "firefox", "Fire", "Firefox - Mozilla", "ref", "",
+        "a.b", "a", "a...", "a\\", "a\\xyz", "x", "y", "a(b)", "fox"
+    };
+
+    int failed = 0;
+    for (unsigned int p = 0; p < sizeof(patterns)/sizeof(patterns[0]); ++p) {
+        FbTk::RegExp regexp(patterns[p]);
+        PlainRegExp plain(patterns[p]);
+        for (unsigned int s = 0; s < sizeof(strings)/sizeof(strings[0]); ++s) {
+            if (regexp.match(strings[s]) != plain.match(strings[s])) {
+                printf("  %-12s on %-18s FAILED\n", patterns[p], strings[s]);
+                ++failed;
+            }
+        }
+    }
+    printf("done, %d differences.\n", failed);
+    return failed;
+}
+
+/// the terms of a typical apps file against typical window properties
+int bench_regexp() {
+
+    const char *patterns[] = {
+        "Firefox", "XTerm", "Gimp.*", ".*Thunderbird", ".*vim.*", "[Ee]ditor.*"
+    };
+    const char *strings[] = {
+        "Navigator", "Firefox", "xterm", "XTerm", "vim - notes.txt - XTerm",
+        "Inbox - Mozilla Thunderbird", "GNU Image Manipulation Program"
+    };
+    const int num_patterns = sizeof(patterns)/sizeof(patterns[0]);
+    const int num_strings = sizeof(strings)/sizeof(strings[0]);
+    const int count = 100000;
+
+    vector<string> texts(strings, strings + num_strings);
+    vector<FbTk::RegExp *> regexps;
+    vector<PlainRegExp *> plains;
+    for (int p = 0; p < num_patterns; ++p) {
+        regexps.push_back(new FbTk::RegExp(patterns[p]));
+        plains.push_back(new PlainRegExp(patterns[p]));
+    }
+
+    timeval start;
+    int plain_matches = 0;
+    gettimeofday(&start, 0);
+    for (int i = 0; i < count; ++i)
+        for (int p = 0; p < num_patterns; ++p)
+            for (int s = 0; s < num_strings; ++s)
+                plain_matches += plains[p]->match(texts[s]);
+    double plain = elapsed(start);
+
+    int matches = 0;
+    gettimeofday(&start, 0);
+    for (int i = 0; i < count; ++i)
+        for (int p = 0; p < num_patterns; ++p)
+            for (int s = 0; s < num_strings; ++s)
+                matches += regexps[p]->match(texts[s]);
+    double classified = elapsed(start);
+
+    printf("%d matches of %d patterns against %d strings\n",
+           count, num_patterns, num_strings);
+    printf("  regexec:          %fs, %d matches\n", plain, plain_matches);
+    printf("  literal patterns: %fs, %d matches\n", classified, matches);
+
+    for (int p = 0; p < num_patterns; ++p) {
+        delete regexps[p];
+        delete plains[p];
+    }
+
+    return matches == plain_matches ? 0 : 1;
+}
+#endif // USE_REGEXP
+
+int test_match() {
+
+    printf("testing ClientPattern::match()\n");
+
+    struct _t {
+        const char *pattern;
+        bool truth;
+    };
+
+    TestWindow win = { "vim - notes.txt", "xterm", "XTerm", 2 };
+
+    _t tests[] = {
+        { "(xterm)", true },
+        { "(name=xterm)", true },
+        { "(name=xter)", false },
+        { "(class=XTerm) (name=xterm)", true },
+        { "(class!=XTerm)", false },
+        { "(title=vim.*)", true },
+        { "(title=.*notes.*)", true },
+        { "(title=vim)", false },
+        { "(workspace=2)", true },
+        { "(workspace=02)", false },
+        { "(workspace!=2)", false },
+        { "(workspace=[1-3])", true },
+        { "(class=XTerm) (workspace=3)", false },
+        { "(name=x.erm)", true },
+        { "(title=vim - notes\\.txt)", true },
+        { "(title=vim - notes\\.tx)", false }
+    };
+
+    int failed = 0;
+    for (unsigned int i = 0; i < sizeof(tests)/sizeof(_t); ++i) {
+        ClientPattern pat(tests[i].pattern);
+        WindowProperties props(win);
+        bool result = pat.match(props);
+        printf("  %2u: %-30s %s\n", i, tests[i].pattern,
+               result == tests[i].truth ? "ok" : "FAILED");
+        if (result != tests[i].truth)
+            ++failed;
+    }
+    printf("done.\n");
+    return failed;
+}
+
+/// first match of 1000 windows against a 500 entry apps file
+int bench_match() {
+
+    const int num_windows = 1000;
+    const int num_patterns = 500;
+
+    vector<ClientPattern *> patterns;
+    for (int i = 0; i < num_patterns; ++i) {
+        string pat;
+        switch (i % 5) {
+        case 0:
+        case 1:
+            pat = "(name=app" + number(i) + ") (class=App" + number(i) + ")";
+            break;
+        case 2:
+            pat = "(class=App" + number(i) + ") (workspace=" + number(i % 4) + ")";
+            break;
+        case 3:
+            pat = "(title=.*document" + number(i) + ".*)";
+            break;
+        default:
+            pat = "(name=app" + number(i) + ") (title=[Ee]ditor.*)";
+            break;
+        }
+        patterns.push_back(new ClientPattern(pat.c_str()));
+    }
+
+    vector<TestWindow> windows(num_windows);
+    for (int i = 0; i < num_windows; ++i) {
+        int app = (i * 7) % (num_patterns * 2); // half of them match nothing
+        windows[i].name = "app" + number(app);
+        windows[i].klass = "App" + number(app);
+        windows[i].title = "Editor - document" + number(app);
+        windows[i].workspace = i % 4;
+    }
+
+    timeval start;
+    int shared_matches = 0, shared_fetches = 0;
+    gettimeofday(&start, 0);
+    for (int w = 0; w < num_windows; ++w) {
+        WindowProperties props(windows[w]);
+        for (int p = 0; p < num_patterns; ++p) {
+            if (patterns[p]->match(props)) {
+                ++shared_matches;
+                break;
+            }
+        }
+        shared_fetches += props.fetches;
+    }
+    double shared = elapsed(start);
+
+    // what every pattern fetching the properties on its own costs
+    int single_matches = 0, single_fetches = 0;
+    gettimeofday(&start, 0);
+    for (int w = 0; w < num_windows; ++w) {
+        for (int p = 0; p < num_patterns; ++p) {
+            WindowProperties props(windows[w]);
+            bool matched = patterns[p]->match(props);
+            single_fetches += props.fetches;
+            if (matched) {
+                ++single_matches;
+                break;
+            }
+        }
+    }
+    double single = elapsed(start);
+
+    printf("%d windows against %d patterns\n", num_windows, num_patterns);
+    printf("  shared properties:      %fs, %d fetches, %d matches\n",
+           shared, shared_fetches, shared_matches);
+    printf("  per pattern properties: %fs, %d fetches, %d matches\n",
+           single, single_fetches, single_matches);
+
+    for (int i = 0; i < num_patterns; ++i)
+        delete patterns[i];
+
+    return shared_matches == single_matches ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+
+    int failed = test_match();
+#ifdef USE_REGEXP
+    failed += test_regexp();
+    failed += bench_regexp();
+#endif // USE_REGEXP
+    failed += bench_match();
+
+    return failed;
+}
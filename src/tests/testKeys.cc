@@ -20,11 +20,95 @@
 // DEALINGS IN THE SOFTWARE.
 
 #include <iostream>
+#include <list>
 #include "../FbTk/App.hh"
 #include "../FbTk/KeyUtil.hh"
+#include "KeyBindingIndex.hh"
+#include "benchmark.hh"
 
 using namespace std;
 
+namespace {
+
+struct Binding {
+    Binding(int t, unsigned int m, unsigned int k, int c, bool d):
+        type(t), mod(m), key(k), context(c), isdouble(d) { }
+    int type;
+    unsigned int mod;
+    unsigned int key;
+    int context;
+    bool isdouble;
+};
+
+// the way Keys::t_key::find used to do it
+Binding *linearFind(const list<Binding *> &keylist, int type, unsigned int mod,
+                    unsigned int key, int context, bool isdouble) {
+    list<Binding *>::const_iterator it = keylist.begin();
+    for (; it != keylist.end(); ++it) {
+        if ((*it)->type == type && (*it)->key == key &&
+            ((*it)->context & context) > 0 &&
+            (*it)->isdouble == isdouble && (*it)->mod == mod)
+            return *it;
+    }
+    return 0;
+}
+
+} // end anonymous namespace
+
+/// compare the keytree lookup with a linear scan over a big keys file
+void benchKeyIndex() {
+    const int contexts = 11; // Keys::GLOBAL .. Keys::ON_SLIT
+    const unsigned int mods[] = { 0, ShiftMask, ControlMask, Mod1Mask, Mod4Mask };
+    const int types[] = { ButtonPress, ButtonRelease, MotionNotify };
+
+    list<Binding *> keylist;
+    KeyBindingIndex<Binding *> index;
+    for (int c = 0; c < contexts; ++c)
+        for (unsigned int m = 0; m < 5; ++m)
+            for (int t = 0; t < 3; ++t)
+                for (unsigned int button = 1; button <= 5; ++button) {
+                    Binding *b = new Binding(types[t], mods[m], button, 1 << c, false);
+                    keylist.push_back(b);
+                    index.insert(b);
+                }
+    for (unsigned int key = 10; key < 160; ++key) {
+        Binding *b = new Binding(KeyPress, Mod4Mask, key, 1, false);
+        keylist.push_back(b);
+        index.insert(b);
+    }
+
+    // motion events with no binding are the common case
+    const int loops = 200000;
+    unsigned int found_linear = 0, found_index = 0;
+    timeval start;
+
+    gettimeofday(&start, 0);
+    for (int i = 0; i < loops; ++i) {
+        int context = 1 << (i % contexts);
+        if (linearFind(keylist, MotionNotify, mods[i % 5], 1 + i % 8, context, false))
+            ++found_linear;
+    }
+    double linear = elapsed(start);
+
+    gettimeofday(&start, 0);
+    for (int i = 0; i < loops; ++i) {
+        int context = 1 << (i % contexts);
+        if (index.find(MotionNotify, mods[i % 5], 1 + i % 8, context, false))
+            ++found_index;
+    }
+    double indexed = elapsed(start);
+
+    cerr<<keylist.size()<<" bindings, "<<loops<<" lookups"<<endl;
+    cerr<<"linear:  "<<linear<<"s"<<endl;
+    cerr<<"indexed: "<<indexed<<"s"<<endl;
+    cerr<<"results "<<(found_linear == found_index ? "match" : "DIFFER")<<endl;
+
+    while (!keylist.empty()) {
+        delete keylist.front();
+        keylist.pop_front();
+    }
+}
+
 void testKeys(int argc, char **argv) {
     FbTk::App app(0);
     if (app.display() == 0) {
@@ -44,5 +128,6 @@ int main(int argc, char **argv) {
 #ifdef UDS
     uds::Init uds_init;
 #endif
+    benchKeyIndex();
     testKeys(argc, argv);	
 }
@@ -0,0 +1,423 @@
+// testParse.cc
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "FbMenuParser.hh"
+#include "KeyBindingLine.hh"
+#include "RememberApp.hh"
+#include "Keys.hh"
+#include "FbTk/Tokenizer.hh"
+#include "FbTk/StringUtil.hh"
+#include "FbTk/KeyUtil.hh"
+#include "benchmark.hh"
+
+#include <X11/Xlib.h>
+#include <X11/keysym.h>
+
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+using std::ifstream;
+using std::ofstream;
+
+namespace {
+
+string tempFile(const string &contents) {
+    char name[] = "/tmp/fbparseXXXXXX";
+    int fd = mkstemp(name);
+    if (fd < 0)
+        return "";
+    close(fd);
+    ofstream out(name);
+    out << contents;
+    return name;
+}
+
+string number(int n) {
+    return FbTk::StringUtil::number2String(n);
+}
+
+int check(bool ok, const char *what) {
+    printf("  %-45s %s\n", what, ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+} // end anonymous namespace
+
+int test_tokenizer() {
+    printf("testing FbTk::Tokenizer\n");
+    int failed = 0;
+
+    string data = "  Mod1 Tab :NextWindow\n\n[exec] (a \\) b) {xterm}\nlast";
+    FbTk::Tokenizer tok(data.data(), data.size());
+    FbTk::Token t;
+
+    failed += check(tok.nextLine() && tok.row() == 1, "first line");
+    failed += check(tok.word(t) && t == "Mod1", "word");
+    failed += check(tok.word(t) && t.iequals("TAB"), "case insensitive compare");
+    failed += check(tok.word(t) && t.str() == ":NextWindow" && !tok.word(t),
+                    "last word of line");
+    failed += check(tok.nextLine() && tok.line().empty(), "empty line");
+    failed += check(tok.nextLine() && tok.between('[', ']', t) && t == "exec",
+                    "between");
+    failed += check(tok.between('(', ')', t) && t.str() == "a ) b",
+                    "escaped end character");
+    failed += check(!tok.between('<', '>', t) && tok.between('{', '}', t) &&
+                    t == "xterm", "failed between consumes nothing");
+    failed += check(tok.nextLine() && tok.line() == "last" && tok.row() == 4,
+                    "line without newline");
+    failed += check(!tok.nextLine() && tok.eof(), "eof");
+
+    string menu = tempFile("[begin] (Menu)\n"
+                           "  [exec] (X \\) Y) {xterm} <icon.png>\n"
+                           "\n"
+                           "[end]");
+    FbMenuParser parser(menu);
+    FbTk::Parser::Item key, label, cmd, icon;
+    parser >> key >> label;
+    failed += check(parser.isLoaded() && key.second == "begin" &&
+                    label.second == "Menu", "FbMenuParser begin");
+    parser >> cmd >> icon >> key >> label >> cmd >> icon;
+    failed += check(key.second == "exec" && label.second == "X ) Y" &&
+                    cmd.second == "xterm" && icon.second == "icon.png",
+                    "FbMenuParser item");
+    parser >> key >> label >> cmd >> icon;
+    failed += check(key.second == "end" && parser.row() == 4, "FbMenuParser end");
+    unlink(menu.c_str());
+
+    printf("done.\n");
+    return failed;
+}
+
+int test_keys() {
+    printf("testing KeyBindingLine\n");
+    int failed = 0;
+
+    string data = "# comment\n"
+        "Mod1 Shift Tab :NextWindow (workspace=[current])\n"
+        "OnTitlebar Double Mouse1 :Shade\n"
+        "chain: Control x Control f :Exec xterm\n"
+        "Mod1 :Exec xterm\n"
+        "Mod1 Tab\n";
+    FbTk::Tokenizer tok(data.data(), data.size());
+    KeyBindingLine line;
+
+    tok.nextLine();
+    failed += check(line.parse(tok) && line.keys().empty(), "comment");
+
+    tok.nextLine();
+    bool ok = line.parse(tok) && line.keys().size() == 1;
+    if (ok) {
+        const KeyBindingLine::Key &k = line.keys()[0];
+        ok = k.type == KeyPress && k.mod == (Mod1Mask|ShiftMask) &&
+            k.sym == XK_Tab && k.key_str == "Tab" && k.context == 0 &&
+            line.keyMode().empty() &&
+            line.command().str() == "NextWindow (workspace=[current])";
+    }
+    failed += check(ok, "key with modifiers");
+
+    tok.nextLine();
+    ok = line.parse(tok) && line.keys().size() == 1;
+    if (ok) {
+        const KeyBindingLine::Key &k = line.keys()[0];
+        ok = k.type == ButtonPress && k.key == 1 && k.sym == NoSymbol &&
+            k.context == Keys::ON_TITLEBAR && k.isdouble;
+    }
+    failed += check(ok, "double click");
+
+    tok.nextLine();
+    ok = line.parse(tok) && line.keys().size() == 2 &&
+        line.keyMode() == "chain:" && line.keys()[1].sym == XK_f &&
+        line.keys()[1].mod == ControlMask && line.command() == "Exec xterm";
+    failed += check(ok, "key chain in a keymode");
+
+    tok.nextLine();
+    failed += check(!line.parse(tok), "modifier without key");
+    tok.nextLine();
+    failed += check(!line.parse(tok), "key without command");
+
+    printf("done.\n");
+    return failed;
+}
+
+int test_apps() {
+    printf("testing parseApp\n");
+    int failed = 0;
+
+    string data = "[app] (name=xterm)\n"
+        "  [Workspace]\t{2}\n"
+        "  # comment\n"
+        "  [Position]\t(LowerRight)\t{10 -20}\n"
+        "  [Deco]\t{TOOL}\n"
+        "  [Alpha]\t{300}\n"
+        "  [Maximized]\t{horz}\n"
+        "[end]\n"
+        "[app] (name=next)\n";
+    FbTk::Tokenizer tok(data.data(), data.size());
+    Application app(false, false);
+
+    tok.nextLine();
+    parseApp(tok, app);
+    failed += check(app.workspace_remember && app.workspace == 2, "workspace");
+    failed += check(app.position_remember && app.x == 10 && app.y == -20 &&
+                    app.refc == FluxboxWindow::RIGHTBOTTOM, "position");
+    failed += check(app.decostate_remember &&
+                    app.decostate == WindowState::DECOR_TOOL, "deco");
+    failed += check(app.alpha_remember && app.focused_alpha == 255 &&
+                    app.unfocused_alpha == 255, "alpha");
+    failed += check(app.maximizedstate_remember &&
+                    app.maximizedstate == WindowState::MAX_HORZ, "maximized");
+    failed += check(!app.dimensions_remember && !app.layer_remember,
+                    "only the given attributes");
+    failed += check(tok.nextLine() && tok.row() == 9, "stops after [end]");
+
+    printf("done.\n");
+    return failed;
+}
+
+int bench_menu() {
+    string contents = "[begin] (Fluxbox)\n";
+    for (int i = 1; i < 10000; ++i) {
+        switch (i % 10) {
+        case 0:
+            contents += "[submenu] (Submenu " + number(i) + ")\n";
+            break;
+        case 9:
+            contents += "[end]\n";
+            break;
+        case 5:
+            contents += "  [separator]\n";
+            break;
+        default:
+            contents += "  [exec] (Application " + number(i) + ") {app" +
+                number(i) + " --option} <~/.fluxbox/icons/app" + number(i) + ".png>\n";
+            break;
+        }
+    }
+    string file = tempFile(contents);
+
+    // what FbMenuParser used to do
+    timeval start;
+    gettimeofday(&start, 0);
+    int old_items = 0;
+    {
+        ifstream in(file.c_str());
+        string line;
+        const char delimiters[] = "[](){}<>";
+        while (getline(in, line)) {
+            int pos = 0;
+            for (int i = 0; i < 4; ++i) {
+                string value;
+                int err = FbTk::StringUtil::getStringBetween(value,
+                        line.c_str() + pos, delimiters[2*i], delimiters[2*i + 1]);
+                if (err > 0) {
+                    pos += err;
+                    ++old_items;
+                }
+            }
+        }
+    }
+    double old_time = elapsed(start);
+
+    gettimeofday(&start, 0);
+    int new_items = 0;
+    {
+        FbMenuParser parser(file);
+        FbTk::Parser::Item item;
+        while (!parser.eof()) {
+            parser >> item;
+            if (!item.second.empty())
+                ++new_items;
+        }
+    }
+    double new_time = elapsed(start);
+    unlink(file.c_str());
+
+    printf("10000 line menu file\n");
+    printf("  getline/getStringBetween: %fs, %d items\n", old_time, old_items);
+    printf("  FbMenuParser:             %fs, %d items\n", new_time, new_items);
+    return old_items == new_items ? 0 : 1;
+}
+
+int bench_keys() {
+    string contents;
+    const char *mods[] = { "Mod1", "Mod4", "Control Mod1", "Shift Mod4" };
+    for (int i = 0; i < 2000; ++i) {
+        if (i % 20 == 0)
+            contents += "# bindings for group " + number(i / 20) + "\n";
+        else
+            contents += string("OnDesktop ") + mods[i % 4] + " F" + number(i % 12 + 1) +
+                " :Exec some-command --arg " + number(i) + "\n";
+    }
+    string file = tempFile(contents);
+
+    // what Keys::reload and Keys::addBinding used to do
+    timeval start;
+    gettimeofday(&start, 0);
+    int old_bindings = 0;
+    {
+        ifstream in(file.c_str());
+        string line;
+        while (getline(in, line)) {
+            vector<string> val;
+            FbTk::StringUtil::stringtok(val, line.c_str());
+            if (val.empty() || val[0][0] == '#')
+                continue;
+            unsigned int mod = 0;
+            int context = 0;
+            KeySym sym = NoSymbol;
+            for (size_t i = 0; i < val.size(); ++i) {
+                string arg = FbTk::StringUtil::toLower(val[i]);
+                if (arg[0] == ':') {
+                    if (sym != NoSymbol)
+                        ++old_bindings;
+                    break;
+                }
+                unsigned int tmpmod = FbTk::KeyUtil::getModifier(arg.c_str());
+                if (tmpmod)
+                    mod |= tmpmod;
+                else if (arg == "ondesktop")
+                    context |= Keys::ON_DESKTOP;
+                else
+                    sym = XStringToKeysym(val[i].c_str());
+            }
+        }
+    }
+    double old_time = elapsed(start);
+
+    gettimeofday(&start, 0);
+    int new_bindings = 0;
+    {
+        FbTk::Tokenizer in;
+        in.open(file);
+        KeyBindingLine line;
+        while (in.nextLine()) {
+            if (line.parse(in) && !line.keys().empty() &&
+                line.keys()[0].sym != NoSymbol)
+                ++new_bindings;
+        }
+    }
+    double new_time = elapsed(start);
+    unlink(file.c_str());
+
+    printf("2000 line keys file\n");
+    printf("  getline/stringtok: %fs, %d bindings\n", old_time, old_bindings);
+    printf("  KeyBindingLine:    %fs, %d bindings\n", new_time, new_bindings);
+    return old_bindings == new_bindings ? 0 : 1;
+}
+
+int bench_apps() {
+    string contents;
+    for (int i = 0; i < 1000; ++i) {
+        contents += "[app] (name=app" + number(i) + ") (class=App" + number(i) + ")\n"
+            "  [Workspace]\t{" + number(i % 4) + "}\n"
+            "  [Dimensions]\t{640 480}\n"
+            "  [Position]\t(UPPERLEFT)\t{" + number(i) + " 20}\n"
+            "  [Deco]\t{NORMAL}\n"
+            "[end]\n\n";
+    }
+    string file = tempFile(contents);
+
+    // what Remember::reload and parseApp used to do
+    timeval start;
+    gettimeofday(&start, 0);
+    int old_entries = 0;
+    {
+        ifstream in(file.c_str());
+        string line;
+        bool complete = false;
+        while (getline(in, line)) {
+            FbTk::StringUtil::removeFirstWhitespace(line);
+            FbTk::StringUtil::removeTrailingWhitespace(line);
+            if (line.empty() || line[0] == '#')
+                continue;
+            string key, option, label;
+            int pos = FbTk::StringUtil::getStringBetween(key, line.c_str(), '[', ']');
+            if (pos <= 0)
+                continue;
+            int err = FbTk::StringUtil::getStringBetween(option, line.c_str() + pos, '(', ')');
+            if (err > 0)
+                pos += err;
+            FbTk::StringUtil::getStringBetween(label, line.c_str() + pos, '{', '}');
+            key = FbTk::StringUtil::toLower(key);
+            unsigned int w, h;
+            int x, y;
+            if (key == "app") {
+                complete = true;
+            } else if (key == "workspace") {
+                complete &= FbTk::StringUtil::extractNumber(label, w);
+            } else if (key == "dimensions") {
+                complete &= sscanf(label.c_str(), "%u %u", &w, &h) == 2;
+            } else if (key == "position") {
+                complete &= FluxboxWindow::getCorner(option) != FluxboxWindow::ERROR &&
+                    sscanf(label.c_str(), "%d %d", &x, &y) == 2;
+            } else if (key == "deco") {
+                complete &= WindowState::getDecoMaskFromString(label) != -1;
+            } else if (key == "end" && complete) {
+                ++old_entries;
+            }
+        }
+    }
+    double old_time = elapsed(start);
+
+    gettimeofday(&start, 0);
+    int new_entries = 0;
+    {
+        FbTk::Tokenizer in;
+        in.open(file);
+        Application app(false, false);
+        while (in.nextLine()) {
+            FbTk::Token key;
+            if (!in.between('[', ']', key) || !key.iequals("app"))
+                continue;
+            app.reset();
+            parseApp(in, app);
+            if (app.workspace_remember && app.dimensions_remember &&
+                app.position_remember && app.decostate_remember)
+                ++new_entries;
+        }
+    }
+    double new_time = elapsed(start);
+    unlink(file.c_str());
+
+    printf("1000 entry apps file\n");
+    printf("  getline/getStringBetween: %fs, %d entries\n", old_time, old_entries);
+    printf("  parseApp:                 %fs, %d entries\n", new_time, new_entries);
+    return old_entries == new_entries ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+
+    int failed = test_tokenizer();
+    failed += test_keys();
+    failed += test_apps();
+    failed += bench_menu();
+    failed += bench_keys();
+    failed += bench_apps();
+
+    return failed;
+}
@@ -0,0 +1,110 @@
+// testTextUtils.cc for fluxbox
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "FbTk/TextUtils.hh"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+/// ascii characters are 10 pixels wide, all others 20
+struct CharWidth {
+    unsigned int operator()(const char *text, unsigned int len) const {
+        unsigned int width = 0;
+        for (unsigned int i = 0; i < len; ++i) {
+            unsigned char c = text[i];
+            if (c < 0x80)
+                width += 10;
+            else if ((c & 0xC0) == 0xC0)
+                width += 20;
+        }
+        return width;
+    }
+};
+
+/// the longest start of text that fits, by trying every length
+unsigned int bruteForce(const char *text, unsigned int textlen, int max_width) {
+    unsigned int best = 0;
+    for (unsigned int len = 1; len <= textlen && max_width > 0; ++len) {
+        if (len < textlen && (text[len] & 0xC0) == 0x80)
+            continue; // not a whole character
+        if (static_cast<int>(CharWidth()(text, len)) <= max_width)
+            best = len;
+    }
+    return best;
+}
+
+} // end anonymous namespace
+
+int test_fitText() {
+
+    printf("testing fitTextWidth()\n");
+
+    struct _t {
+        const char *text;
+        int max_width;
+        unsigned int expected;
+    };
+
+    _t tests[] = {
+        { "abc", 0, 0 },
+        { "abc", -5, 0 },
+        { "abc", 30, 3 },
+        { "abc", 29, 2 },
+        // a cut at byte 2 or 3 would land inside the "\xc3\xa4"s
+        { "a\xc3\xa4\xc3\xa4", 49, 3 },
+        { "a\xc3\xa4\xc3\xa4", 29, 1 },
+        // no character starts in the first half of the 4 byte emoji
+        { "\xf0\x9f\x98\x80" "a", 20, 4 },
+        { "\xf0\x9f\x98\x80" "a", 19, 0 }
+    };
+
+    int failed = 0;
+    for (unsigned int i = 0; i < sizeof(tests)/sizeof(_t); ++i) {
+        unsigned int len = FbTk::fitTextWidth(CharWidth(), tests[i].text,
+                                              strlen(tests[i].text), tests[i].max_width);
+        printf("  %2u: width %3d -> %u %s\n", i, tests[i].max_width, len,
+               len == tests[i].expected ? "ok" : "FAILED");
+        if (len != tests[i].expected)
+            ++failed;
+    }
+
+    // every width for mixed one to four byte characters
+    const char *mixed = "x\xc3\xa4y\xe2\x82\xac\xf0\x9f\x98\x80z\xe2\x82\xac\xe2\x82\xac"
+        "\xf0\x9f\x98\x80\xf0\x9f\x98\x80q";
+    const unsigned int mixed_len = strlen(mixed);
+    int mismatches = 0;
+    for (int width = -1; width <= 250; ++width) {
+        if (FbTk::fitTextWidth(CharWidth(), mixed, mixed_len, width) !=
+            bruteForce(mixed, mixed_len, width))
+            ++mismatches;
+    }
+    printf("  every width of a mixed string: %s\n", mismatches == 0 ? "ok" : "FAILED");
+
+    printf("done.\n");
+    return failed + mismatches;
+}
+
+int main(int argc, char **argv) {
+    return test_fitText();
+}
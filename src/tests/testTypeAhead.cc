@@ -0,0 +1,105 @@
+// testTypeAhead.cc for fluxbox
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "FbTk/TypeAhead.hh"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+class Item: public FbTk::ITypeAheadable {
+public:
+    Item(const char *label, bool enabled = true):
+        m_label(label), m_enabled(enabled) { }
+    const std::string &iTypeString() const { return m_label; }
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+private:
+    std::string m_label;
+    bool m_enabled;
+};
+
+typedef std::vector<Item *> Items;
+
+/// the labels of items, joined by ' '
+std::string labels(const Items &items) {
+    std::string ret;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (i > 0)
+            ret += ' ';
+        ret += items[i]->iTypeString();
+    }
+    return ret;
+}
+
+int check(const std::string &got, const char *expected, const char *what) {
+    bool ok = got == expected;
+    printf("  %-30s '%s' %s\n", what, got.c_str(), ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+} // end anonymous namespace
+
+int test_typeAhead() {
+    printf("testing TypeAhead\n");
+    int failed = 0;
+
+    Item alpha("alpha", false), beta("Beta"), apple("apple"), apricot("Apricot");
+    Items items;
+    items.push_back(&alpha);
+    items.push_back(&beta);
+    items.push_back(&apple);
+    items.push_back(&apricot);
+
+    FbTk::TypeAhead<Items, Item *> search;
+    search.init(items);
+
+    failed += check(labels(search.putCharacter('a')), "apple Apricot",
+                    "skips disabled items");
+    failed += check(labels(search.putCharacter('P')), "apple Apricot",
+                    "case insensitive");
+    failed += check(labels(search.putCharacter('r')), "Apricot", "narrows");
+    search.putBackSpace();
+    failed += check(labels(search.matched()), "apple Apricot", "backspace");
+
+    search.reset();
+    search.putCharacter('a');
+    search.seek();
+    failed += check(search.stringSize() == 2 ? "ap" : "?", "ap",
+                    "seek to the common start");
+
+    search.reset();
+    failed += check(labels(search.putCharacter('b')), "Beta", "after reset");
+    alpha.setEnabled(true);
+    search.reset();
+    failed += check(labels(search.putCharacter('a')), "alpha apple Apricot",
+                    "enabled again");
+
+    printf("done.\n");
+    return failed;
+}
+
+int main(int argc, char **argv) {
+    return test_typeAhead();
+}